@@ -48,11 +48,9 @@ absorb_buff_t* absorb_t::create_buff(const action_state_t* s)
   return buff;
 }
 
-void absorb_t::activate()
+uint64_t absorb_t::target_list_generation() const
 {
-  sim->player_non_sleeping_list.register_callback([this](player_t*) {
-    target_cache.is_valid = false;
-    });
+  return sim->player_non_sleeping_list.generation();
 }
 
 void absorb_t::impact(action_state_t* s)
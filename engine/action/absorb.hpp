@@ -25,7 +25,7 @@ struct absorb_t : public spell_base_t
   void assess_damage(result_amount_type, action_state_t*) override;
   result_amount_type amount_type(const action_state_t* /* state */, bool /* periodic */ = false) const override;
   void impact(action_state_t*) override;
-  void activate() override;
+  uint64_t target_list_generation() const override;
   size_t available_targets(std::vector< player_t* >&) const override;
   int num_targets() const override;
 
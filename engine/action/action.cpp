@@ -21,6 +21,7 @@
 #include "player/player_event.hpp"
 #include "player/stats.hpp"
 #include "sim/cooldown.hpp"
+#include "sim/engine_profiler.hpp"
 #include "sim/event.hpp"
 #include "sim/expressions.hpp"
 #include "sim/proc.hpp"
@@ -73,7 +74,10 @@ void do_execute( action_t* action, execute_type type )
       action->total_executions++;
       action->player->sequence_add( action, action->target, action->sim->current_time() );
     }
-    action->execute();
+    {
+      ENGINE_PROFILER_SCOPE( action->sim->engine_profiler.get(), engine_profiler_t::ACTION_EXECUTE, *action );
+      action->execute();
+    }
     action->line_cooldown->start();
 
     // If the ability has a GCD, we need to start it
@@ -256,6 +260,7 @@ struct action_execute_event_t : public player_event_t
       // Action target must follow any potential pre-execute-state target if it differs from the
       // current (default) target of the action.
       action->set_target( target );
+      ENGINE_PROFILER_SCOPE( sim().engine_profiler.get(), engine_profiler_t::ACTION_EXECUTE, *action );
       action->execute();
     }
     else
@@ -464,6 +469,7 @@ action_t::action_t( action_e ty, util::string_view token, player_t* p, const spe
     option(),
     interrupt_global( false ),
     if_expr(),
+    if_expr_cache(),
     target_if_mode( TARGET_IF_NONE ),
     target_if_expr(),
     interrupt_if_expr(),
@@ -482,6 +488,7 @@ action_t::action_t( action_e ty, util::string_view token, player_t* p, const spe
     pre_execute_state(),
     snapshot_flags(),
     update_flags( STATE_TGT_MUL_DA | STATE_TGT_MUL_TA | STATE_TGT_CRIT ),
+    shared_aoe_snapshot( p->sim->shared_aoe_snapshot != 0 ),
     target_cache(),
     options(),
     state_cache(),
@@ -511,6 +518,7 @@ action_t::action_t( action_e ty, util::string_view token, player_t* p, const spe
   }
 
   player->action_list.push_back( this );
+  player->action_registry.add( this );
 
   if ( data().ok() )
   {
@@ -1596,18 +1604,23 @@ size_t action_t::available_targets( std::vector<player_t*>& tl ) const
 std::vector<player_t*>& action_t::target_list() const
 {
   // Check if target cache is still valid. If not, recalculate it
-  if ( !target_cache.is_valid )
+  if ( !target_cache_valid() )
   {
     available_targets( target_cache.list );  // This grabs the full list of targets, which will also pickup various
                                              // awfulness that some classes have.. such as prismatic crystal.
     if ( sim->distance_targeting_enabled )
       check_distance_targeting( target_cache.list );
-    target_cache.is_valid = true;
+    validate_target_cache();
   }
 
   return target_cache.list;
 }
 
+uint64_t action_t::target_list_generation() const
+{
+  return sim->target_non_sleeping_list.generation();
+}
+
 player_t* action_t::find_target_by_number( int number ) const
 {
   std::vector<player_t*>& tl = target_list();
@@ -1719,13 +1732,25 @@ void action_t::execute()
     const int max_targets = as<int>( tl.size() );
     num_targets           = ( num_targets < 0 ) ? max_targets : std::min( max_targets, num_targets );
 
+    // A shared snapshot of the source-side state acts as the pre-execute state of all targets
+    action_state_t* shared_state = nullptr;
+    if ( shared_aoe_snapshot && !pre_execute_state && num_targets > 1 )
+    {
+      shared_state              = get_state();
+      shared_state->target      = tl[ 0 ];
+      shared_state->n_targets   = as<unsigned>( num_targets );
+      snapshot_state( shared_state, amount_type( shared_state ) );
+    }
+
+    const action_state_t* source_state = pre_execute_state ? pre_execute_state : shared_state;
+
     for ( int t = 0; t < num_targets; t++ )
     {
-      action_state_t* s = get_state( pre_execute_state );
+      action_state_t* s = get_state( source_state );
       s->target         = tl[ t ];
       s->n_targets      = as<unsigned>( num_targets );
       s->chain_target   = t;
-      if ( !pre_execute_state )
+      if ( !source_state )
       {
         snapshot_state( s, amount_type( s ) );
       }
@@ -1733,7 +1758,7 @@ void action_t::execute()
       // for aoe spells.
       else
       {
-        snapshot_internal( s, snapshot_flags & STATE_TARGET, pre_execute_state->result_type );
+        snapshot_internal( s, snapshot_flags & STATE_TARGET, source_state->result_type );
       }
       s->result       = calculate_result( s );
       s->block_result = calculate_block_result( s );
@@ -1745,6 +1770,9 @@ void action_t::execute()
 
       schedule_travel( s );
     }
+
+    if ( shared_state )
+      action_state_t::release( shared_state );
   }
   else  // single target
   {
@@ -2431,7 +2459,12 @@ bool action_t::action_ready()
   if ( option.moving != -1 && option.moving != ( player->is_moving() ? 1 : 0 ) )
     return false;
 
-  if ( if_expr && !if_expr->success() )
+  if ( if_expr_cache )
+  {
+    if ( !if_expr_cache->success( sim->current_time(), get_expression_target() ) )
+      return false;
+  }
+  else if ( if_expr && !if_expr->success() )
     return false;
 
   return true;
@@ -2840,6 +2873,18 @@ void action_t::reset()
 
       player->dynamic_target_action_list.erase( this );
     }
+
+    // Cache the final expression once optimization is done. Target cycling actions evaluate the
+    // expression for each candidate target, they are not cached.
+    if ( if_expr_cache )
+    {
+      if_expr_cache->invalidate();
+    }
+    else if ( sim->apl_readiness_cache && sim->current_iteration >= sim->optimize_expressions &&
+              !if_expr->is_constant() && !option.cycle_targets && !target_if_expr )
+    {
+      if_expr_cache = std::make_unique<expression::result_cache_t>( *if_expr, sim->apl_readiness_stats );
+    }
   }
   expr_t::optimize_expression( target_if_expr, *sim );
   expr_t::optimize_expression( interrupt_if_expr, *sim );
@@ -4072,7 +4117,10 @@ void action_t::do_schedule_travel( action_state_t* state, timespan_t time_ )
 {
   if ( time_ <= timespan_t::zero() )
   {
-    impact( state );
+    {
+      ENGINE_PROFILER_SCOPE( sim->engine_profiler.get(), engine_profiler_t::ACTION_IMPACT, *this );
+      impact( state );
+    }
     action_state_t::release( state );
   }
   else
@@ -4707,7 +4755,6 @@ void action_t::acquire_target( retarget_source event, player_t* /* context */, p
 
 void action_t::activate()
 {
-  sim->target_non_sleeping_list.register_callback( [this]( player_t* ) { target_cache.is_valid = false; } );
 }
 
 // Change the target of the action, may require invalidation of target cache
@@ -4930,11 +4977,11 @@ player_t* action_t::select_target_if_target()
   std::vector<player_t*> master_list;
   if ( sim->distance_targeting_enabled )
   {
-    if ( !target_cache.is_valid )
+    if ( !target_cache_valid() )
     {
       available_targets( target_cache.list );
       master_list = targets_in_range_list( target_cache.list );
-      target_cache.is_valid = true;
+      validate_target_cache();
     }
     else
     {
@@ -42,6 +42,9 @@ struct spelleffect_data_t;
 struct stats_t;
 struct travel_event_t;
 struct weapon_t;
+namespace expression {
+  class result_cache_t;
+}
 namespace io {
   class ofstream;
 }
@@ -511,6 +514,9 @@ public:
 
   std::unique_ptr<expr_t> if_expr;
 
+  /// Result of if_expr, reused while its inputs are unchanged ( sim_t::apl_readiness_cache )
+  std::unique_ptr<expression::result_cache_t> if_expr_cache;
+
   enum target_if_mode_e
   {
     TARGET_IF_NONE,
@@ -562,18 +568,26 @@ public:
 
   unsigned update_flags;
 
+  /// Snapshot the source-side state of an aoe execute once, and share it between the targets. Only
+  /// STATE_TARGET fields are snapshot for each target. Actions whose source-side composites depend
+  /// on the target must not enable this. Defaults to the sim-wide shared_aoe_snapshot option.
+  bool shared_aoe_snapshot;
+
   /**
    * Target Cache System
    * - list: contains the cached target pointers
-   * - callback: unique_Ptr to callback
-   * - is_valid: gets invalidated by the callback from the target list source.
+   * - is_valid: cleared to force recalculation of the list
+   * - generation: generation of the sim target list the list was calculated from, see
+   *   action_t::target_list_generation(). Changes to the sim target list invalidate the cache
+   *   without having to notify every action.
    *  When the target list is requested in action_t::target_list(), it gets recalculated if
-   *  flag is false, otherwise cached version is used
+   *  the cache is not valid (action_t::target_cache_valid()), otherwise cached version is used
    */
   struct target_cache_t {
     std::vector< player_t* > list;
     bool is_valid;
-    target_cache_t() : is_valid( false ) {}
+    uint64_t generation;
+    target_cache_t() : is_valid( false ), generation( 0 ) {}
   } mutable target_cache;
 
 private:
@@ -773,6 +787,18 @@ public:
 
   virtual std::vector< player_t* >& target_list() const;
 
+  /// Generation of the sim actor list the target cache is calculated from
+  virtual uint64_t target_list_generation() const;
+
+  bool target_cache_valid() const
+  { return target_cache.is_valid && target_cache.generation == target_list_generation(); }
+
+  void validate_target_cache() const
+  {
+    target_cache.is_valid = true;
+    target_cache.generation = target_list_generation();
+  }
+
   virtual player_t* find_target_by_number( int number ) const;
 
   virtual bool execute_targeting( action_t* action ) const;
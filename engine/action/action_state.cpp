@@ -6,6 +6,7 @@
 #include "action/action_state.hpp"
 #include "action/action.hpp"
 #include "player/player.hpp"
+#include "sim/engine_profiler.hpp"
 #include "sim/sim.hpp"
 #include <sstream>
 
@@ -262,6 +263,7 @@ void travel_event_t::execute()
 {
   if ( !state->target->is_sleeping() )
   {
+    ENGINE_PROFILER_SCOPE( sim().engine_profiler.get(), engine_profiler_t::ACTION_IMPACT, *action );
     action->impact( state );
   }
 
@@ -8,6 +8,7 @@
 #include "action/action_state.hpp"
 #include "player/player.hpp"
 #include "player/stats.hpp"
+#include "sim/engine_profiler.hpp"
 #include "sim/expressions.hpp"
 #include "sim/sim.hpp"
 #include "sim/event.hpp"
@@ -764,6 +765,7 @@ void dot_t::tick()
   sim.print_debug( "{} ticks ({} of {}). duration={} time_to_tick={} remains={}", *this, current_tick, num_ticks(),
                    current_duration, time_to_tick(), remains() );
 
+  ENGINE_PROFILER_SCOPE( sim.engine_profiler.get(), engine_profiler_t::ACTION_TICK, *current_action );
   current_action->tick( this );
 }
 
@@ -39,11 +39,9 @@ heal_t::heal_t( util::string_view name, player_t* p, const spell_data_t* s )
   }
 }
 
-void heal_t::activate()
+uint64_t heal_t::target_list_generation() const
 {
-  sim->player_non_sleeping_list.register_callback( [ this ]( player_t* ) {
-    target_cache.is_valid = false;
-  } );
+  return sim->player_non_sleeping_list.generation();
 }
 
 void heal_t::parse_heal_effect_data( const spelleffect_data_t& e )
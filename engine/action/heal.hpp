@@ -42,7 +42,7 @@ public:
   result_amount_type amount_type( const action_state_t* /* state */, bool /* periodic */ = false ) const override;
   result_amount_type report_amount_type( const action_state_t* /* state */ ) const override;
   size_t available_targets( std::vector<player_t*>& ) const override;
-  void activate() override;
+  uint64_t target_list_generation() const override;
   double calculate_direct_amount( action_state_t* state ) const override;
   double calculate_tick_amount( action_state_t* state, double dmg_multiplier ) const override;
   int num_targets() const override;
@@ -97,9 +97,161 @@ struct parse_buff_effects_t
   };
 
 private:
+  // Compiled buff effect list ( buff_effects_cache=1 ). Entries whose value only depends on the stack of their buff
+  // ( and mastery ) are folded into a cached value, which is recomputed when the stack of a buff changes anywhere in
+  // the simulation ( sim_t::buff_stack_generation ) and one of the referenced stacks differs. Conditional entries and
+  // entries using the current value of their buff are evaluated on every call.
+  struct buff_effect_cache_t
+  {
+    const std::vector<buff_effect_t>* list;
+    bool flat;
+    size_t list_size = 0;
+    std::vector<size_t> cached_effects;
+    std::vector<size_t> dynamic_effects;
+    std::vector<std::pair<buff_t*, int>> buff_stacks;
+    bool uses_mastery = false;
+    bool valid = false;
+    double mastery = 0.0;
+    double value = 0.0;
+    uint64_t generation = 0;
+    int benefit_iteration = -1;
+    timespan_t benefit_time = timespan_t::min();
+
+    buff_effect_cache_t( const std::vector<buff_effect_t>* l, bool f ) : list( l ), flat( f ) {}
+  };
+
   action_t* action_;
   std::vector<std::pair<size_t, double>> effect_flat_modifiers;
   std::vector<std::pair<size_t, double>> effect_pct_modifiers;
+  mutable std::vector<buff_effect_cache_t> buff_effect_caches;
+
+  void apply_buff_effect( double& return_value, const buff_effect_t& i, bool flat, bool benefit ) const
+  {
+    double eff_val = i.value;
+    int mod = 1;
+
+    if ( i.func && !i.func() )
+      return;  // continue to next effect if conditional effect function is false
+
+    if ( i.buff )
+    {
+      auto stack = benefit ? i.buff->stack() : i.buff->check();
+
+      if ( !stack )
+        return;  // continue to next effect if stacks == 0 (buff is down)
+
+      mod = i.use_stacks ? stack : 1;
+
+      if ( i.type == USE_CURRENT )
+        eff_val = i.buff->check_value();
+    }
+
+    if ( i.mastery )
+      eff_val *= action_->player->cache.mastery();
+
+    if ( flat )
+      return_value += eff_val * mod;
+    else
+      return_value *= 1.0 + eff_val * mod;
+  }
+
+  void compile_buff_effects( buff_effect_cache_t& cache ) const
+  {
+    const auto& buffeffects = *cache.list;
+
+    cache.list_size = buffeffects.size();
+    cache.cached_effects.clear();
+    cache.dynamic_effects.clear();
+    cache.buff_stacks.clear();
+    cache.uses_mastery = false;
+    cache.valid = false;
+
+    for ( size_t idx = 0; idx < buffeffects.size(); idx++ )
+    {
+      const auto& i = buffeffects[ idx ];
+
+      if ( i.func || ( i.buff && i.type == USE_CURRENT ) )
+      {
+        cache.dynamic_effects.push_back( idx );
+        continue;
+      }
+
+      cache.cached_effects.push_back( idx );
+      cache.uses_mastery |= i.mastery;
+
+      if ( i.buff && !range::contains( cache.buff_stacks, i.buff, &std::pair<buff_t*, int>::first ) )
+        cache.buff_stacks.emplace_back( i.buff, 0 );
+    }
+  }
+
+  bool cached_buff_effects_current( buff_effect_cache_t& cache ) const
+  {
+    if ( !cache.valid )
+      return false;
+
+    if ( cache.uses_mastery && cache.mastery != action_->player->cache.mastery() )
+      return false;
+
+    if ( cache.generation == action_->sim->buff_stack_generation )
+      return true;
+
+    // Some buff changed its stack, the cached value is still current if none of ours did
+    for ( const auto& [ buff, stack ] : cache.buff_stacks )
+    {
+      if ( buff->check() != stack )
+        return false;
+    }
+
+    cache.generation = action_->sim->buff_stack_generation;
+    return true;
+  }
+
+  double get_cached_buff_effects_value( const std::vector<buff_effect_t>& buffeffects, bool flat, bool benefit ) const
+  {
+    auto it = range::find_if( buff_effect_caches, [ &buffeffects, flat ]( const buff_effect_cache_t& c ) {
+      return c.list == &buffeffects && c.flat == flat;
+    } );
+    if ( it == buff_effect_caches.end() )
+    {
+      buff_effect_caches.emplace_back( &buffeffects, flat );
+      it = buff_effect_caches.end() - 1;
+    }
+
+    auto& cache = *it;
+    if ( cache.list_size != buffeffects.size() )
+      compile_buff_effects( cache );
+
+    if ( !cached_buff_effects_current( cache ) )
+    {
+      cache.value = flat ? 0.0 : 1.0;
+      for ( auto idx : cache.cached_effects )
+        apply_buff_effect( cache.value, buffeffects[ idx ], flat, false );
+
+      for ( auto& bs : cache.buff_stacks )
+        bs.second = bs.first->check();
+
+      cache.mastery = cache.uses_mastery ? action_->player->cache.mastery() : 0.0;
+      cache.generation = action_->sim->buff_stack_generation;
+      cache.valid = true;
+    }
+
+    // Benefit of the cached buffs is recorded once per timestamp, as buff_t::stack() would
+    if ( benefit && ( cache.benefit_time != action_->sim->current_time() ||
+                      cache.benefit_iteration != action_->sim->current_iteration ) )
+    {
+      for ( const auto& bs : cache.buff_stacks )
+        bs.first->stack();
+
+      cache.benefit_time = action_->sim->current_time();
+      cache.benefit_iteration = action_->sim->current_iteration;
+    }
+
+    double return_value = cache.value;
+    for ( auto idx : cache.dynamic_effects )
+      apply_buff_effect( return_value, buffeffects[ idx ], flat, benefit );
+
+    return return_value;
+  }
 
 public:
   // auto parsed dynamic effects
@@ -398,37 +550,13 @@ public:
   double get_buff_effects_value( const std::vector<buff_effect_t>& buffeffects, bool flat = false,
                                  bool benefit = true ) const
   {
+    if ( action_->sim->buff_effects_cache )
+      return get_cached_buff_effects_value( buffeffects, flat, benefit );
+
     double return_value = flat ? 0.0 : 1.0;
 
     for ( const auto& i : buffeffects )
-    {
-      double eff_val = i.value;
-      int mod = 1;
-
-      if ( i.func && !i.func() )
-          continue;  // continue to next effect if conditional effect function is false
-
-      if ( i.buff )
-      {
-        auto stack = benefit ? i.buff->stack() : i.buff->check();
-
-        if ( !stack )
-          continue;  // continue to next effect if stacks == 0 (buff is down)
-
-        mod = i.use_stacks ? stack : 1;
-
-        if ( i.type == USE_CURRENT )
-          eff_val = i.buff->check_value();
-      }
-
-      if ( i.mastery )
-        eff_val *= action_->player->cache.mastery();
-
-      if ( flat )
-        return_value += eff_val * mod;
-      else
-        return_value *= 1.0 + eff_val * mod;
-    }
+      apply_buff_effect( return_value, i, flat, benefit );
 
     return return_value;
   }
@@ -49,6 +49,14 @@ stats_t::stats_t( util::string_view n, player_t* p ) :
   scaling( nullptr ),
   timeline_amount( nullptr )
 {
+  if ( sim.streaming_sample_data )
+  {
+    actual_amount.set_streaming( true );
+    total_amount.set_streaming( true );
+    portion_aps.set_streaming( true );
+    portion_apse.set_streaming( true );
+  }
+
   int size = std::min( sim.iterations, 10000 );
   actual_amount.reserve( size );
   total_amount.reserve( size );
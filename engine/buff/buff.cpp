@@ -34,10 +34,12 @@ struct buff_expr_t : public expr_t
   action_t* action;
   buff_t* static_buff;
   target_specific_t<buff_t> specific_buff;
+  // The result only depends on the stack count of the buff
+  bool stack_dependent;
 
   buff_expr_t( util::string_view n, util::string_view bn, action_t* a, buff_t* b )
     : expr_t( get_full_expression_name( n, bn ) ), buff_name( bn ), action( a ),
-    static_buff( b ), specific_buff( false )
+    static_buff( b ), specific_buff( false ), stack_dependent( false )
   {
   }
 
@@ -95,6 +97,17 @@ struct buff_expr_t : public expr_t
   {
     return buff()->s_data != spell_data_t::nil() && !buff()->s_data->ok();
   }
+
+  bool dependencies( expression::dependencies_t& deps ) override
+  {
+    if ( !stack_dependent )
+    {
+      return false;
+    }
+
+    deps.watch( buff()->current_stack );
+    return true;
+  }
 };
 
 template <typename Fn>
@@ -403,7 +416,7 @@ std::unique_ptr<expr_t> create_buff_expression( util::string_view buff_name, uti
   }
   else if ( type == "up" )
   {
-    return make_const_buff_expr( "buff_up",
+    auto expr = make_const_buff_expr( "buff_up",
       []( buff_t* buff ) {
         return buff->check() > 0;
       },
@@ -411,26 +424,32 @@ std::unique_ptr<expr_t> create_buff_expression( util::string_view buff_name, uti
         assert( buff->check() == 0 || buff->default_chance != 0);
         return buff->default_chance == 0;
       } );
+    expr->stack_dependent = true;
+    return expr;
   }
   else if ( type == "down" )
   {
-    return make_const_buff_expr( "buff_down",
+    auto expr = make_const_buff_expr( "buff_down",
       []( buff_t* buff ) {
         return buff->check() <= 0;
       },
       []( buff_t* buff ) {
         return buff->default_chance == 0;
       } );
+    expr->stack_dependent = true;
+    return expr;
   }
   else if ( type == "stack" )
   {
-    return make_const_buff_expr( "buff_stack",
+    auto expr = make_const_buff_expr( "buff_stack",
       []( buff_t* buff ) {
         return buff->check();
       },
       []( buff_t* buff ) {
         return buff->default_chance == 0;
       } );
+    expr->stack_dependent = true;
+    return expr;
   }
   else if ( type == "stack_pct" )
   {
@@ -679,6 +698,7 @@ buff_t::buff_t( sim_t* sim, player_t* target, player_t* source, util::string_vie
       return f.first == name && f.second == source;
     } ), fl.end() );
     player->buff_list.push_back( this );
+    player->buff_registry.add( this );
     cooldown = source->get_cooldown( "buff_" + name_str );
   }
   else  // Sim Buffs
@@ -2106,6 +2126,7 @@ void buff_t::decrement( int stacks, double value )
       stack_uptime[ current_stack ].update( false, sim->current_time() );
 
     current_stack -= stacks;
+    sim->buff_stack_generation++;
 
     if ( value != DEFAULT_VALUE() )
       current_value = value;
@@ -2420,6 +2441,7 @@ void buff_t::bump( int stacks, double value )
   if ( max_stack() < 0 )
   {
     current_stack += stacks;
+    sim->buff_stack_generation++;
     changes_stack_value = true;
   }
   // Asynchronous buffs need to adjust their expiration even when bumped at max stacks.
@@ -2429,6 +2451,7 @@ void buff_t::bump( int stacks, double value )
     int before_stack = current_stack;
 
     current_stack += stacks;
+    sim->buff_stack_generation++;
     if ( current_stack > max_stack() )
     {
       int overflow = current_stack - max_stack();
@@ -2624,6 +2647,7 @@ void buff_t::expire( timespan_t delay )
   int old_stack = current_stack;
 
   current_stack = 0;
+  sim->buff_stack_generation++;
 
   if ( last_start >= timespan_t::zero() )
   {
@@ -2925,7 +2949,8 @@ buff_t* buff_t::find( player_t* p, util::string_view name, player_t* source )
     if ( fb.first == name && fb.second == source )
       return p->sim->auras.fallback;
 
-  return find( p->buff_list, name, source );
+  return p->buff_registry.find( p->buff_list, name,
+      [ source ]( const buff_t& buff ) { return !source || source == buff.source; } );
 }
 
 const char* buff_t::name_reporting() const
@@ -3266,6 +3291,7 @@ void stat_buff_t::decrement( int stacks, double /* value */ )
       buff_stat.current_value -= delta;
     }
     current_stack -= stacks;
+    sim->buff_stack_generation++;
 
     invalidate_cache();
 
@@ -3371,6 +3397,7 @@ void cost_reduction_buff_t::decrement( int stacks, double /* value */ )
     double delta = amount * stacks;
     player->cost_reduction_loss( school, delta );
     current_stack -= stacks;
+    sim->buff_stack_generation++;
     current_value -= delta;
   }
 }
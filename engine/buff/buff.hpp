@@ -44,6 +44,9 @@ struct spell_data_t;
 namespace rng{
 struct rng_t;
 }
+namespace snapshot {
+class archive_t;
+}
 
 
 using buff_tick_callback_t = std::function<void(buff_t* buff, int current_tick, timespan_t tick_time)>;
@@ -275,6 +278,16 @@ public:
   virtual void aura_loss();
   virtual void merge( const buff_t& other_buff );
   virtual void analyze();
+
+  // Collected state of buff_t::merge(), for sim snapshots
+  template <typename Archive>
+  void serialize( Archive& ar )
+  {
+    ar( start_intervals, trigger_intervals, duration_lengths, uptime_pct, benefit_pct, trigger_pct, avg_start,
+        avg_refresh, avg_expire, avg_overflow_count, avg_overflow_total, uptime_array, stack_uptime );
+  }
+  /// State that an override of merge() merges, written to and merged from snapshots ( sim/snapshot.hpp )
+  virtual void serialize_snapshot( snapshot::archive_t& ) { }
   virtual void datacollection_begin();
   virtual void datacollection_end();
 
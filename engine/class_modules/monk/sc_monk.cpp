@@ -5483,13 +5483,13 @@ namespace monk
         std::vector<player_t *> &target_list() const override
         {
           // Check if target cache is still valid. If not, recalculate it
-          if ( !target_cache.is_valid )
+          if ( !target_cache_valid() )
           {
             available_targets( target_cache.list );  // This grabs the full list of targets, which will also pickup various
                                                      // awfulness that some classes have.. such as prismatic crystal.
             if ( sim->distance_targeting_enabled )
               check_distance_targeting( target_cache.list );
-            target_cache.is_valid = true;
+            validate_target_cache();
           }
 
           if ( !target_cache.list.empty() )
@@ -10644,6 +10644,14 @@ namespace monk
     sample_datas.stagger_pct_timeline.merge( other_monk.sample_datas.stagger_pct_timeline );
   }
 
+  void monk_t::serialize_snapshot( snapshot::archive_t &ar )
+  {
+    base_t::serialize_snapshot( ar );
+
+    ar( sample_datas.stagger_effective_damage_timeline, sample_datas.stagger_damage_pct_timeline,
+        sample_datas.stagger_pct_timeline );
+  }
+
   // monk_t::monk_report =================================================
 
   /* Report Extension Class
@@ -1084,6 +1084,7 @@ namespace monk
     const spell_data_t *find_spell_override( const spell_data_t *base, const spell_data_t *passive );
     void apply_affecting_auras( action_t & ) override;
     void merge( player_t &other ) override;
+    void serialize_snapshot( snapshot::archive_t &ar ) override;
     void moving() override;
 
     // Custom Monk Functions
@@ -1358,6 +1358,7 @@ public:
   double    resource_loss( resource_e resource_type, double amount, gain_t* g = nullptr, action_t* a = nullptr ) override;
   void      copy_from( player_t* source ) override;
   void      merge( player_t& other ) override;
+  void      serialize_snapshot( snapshot::archive_t& ar ) override;
   void      datacollection_begin() override;
   void      datacollection_end() override;
   void      analyze( sim_t& sim ) override;
@@ -8621,6 +8622,13 @@ void death_knight_t::merge( player_t& other )
 
 }
 
+void death_knight_t::serialize_snapshot( snapshot::archive_t& ar )
+{
+  player_t::serialize_snapshot( ar );
+
+  ar( _runes.rune_waste, _runes.cumulative_waste );
+}
+
 std::string death_knight_t::create_profile( save_e type )
 {
   std::string term;
@@ -841,6 +841,7 @@ public:
   void recalculate_resource_max( resource_e, gain_t* source = nullptr ) override;
   void reset() override;
   void merge( player_t& other ) override;
+  void serialize_snapshot( snapshot::archive_t& ar ) override;
   void datacollection_begin() override;
   void datacollection_end() override;
   void target_mitigation( school_e, result_amount_type, action_state_t* ) override;
@@ -8614,6 +8615,20 @@ void demon_hunter_t::merge( player_t& other )
   }
 }
 
+// demon_hunter_t::serialize_snapshot =============================================
+
+void demon_hunter_t::serialize_snapshot( snapshot::archive_t& ar )
+{
+  player_t::serialize_snapshot( ar );
+
+  ar.size( cd_waste_exec.size() );
+  for ( size_t i = 0, end = cd_waste_exec.size(); i < end; i++ )
+  {
+    ar.name( cd_waste_exec[ i ]->first );
+    ar( cd_waste_exec[ i ]->second, cd_waste_cumulative[ i ]->second );
+  }
+}
+
 // demon_hunter_t::datacollection_begin ===========================================
 
 void demon_hunter_t::datacollection_begin()
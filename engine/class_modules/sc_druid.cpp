@@ -189,6 +189,11 @@ struct snapshot_counter_t
     tick.merge( other.tick );
     waste.merge( other.waste );
   }
+
+  void serialize( snapshot::archive_t& ar )
+  {
+    ar( execute, tick, waste );
+  }
 };
 
 struct eclipse_handler_t
@@ -254,6 +259,7 @@ struct eclipse_handler_t
   void datacollection_begin();
   void datacollection_end();
   void merge( const eclipse_handler_t& );
+  void serialize( snapshot::archive_t& );
 };
 
 template <typename Data, typename Base = action_state_t>
@@ -1116,6 +1122,7 @@ public:
   void reset() override;
   void combat_begin() override;
   void merge( player_t& other ) override;
+  void serialize_snapshot( snapshot::archive_t& ar ) override;
   void datacollection_begin() override;
   void datacollection_end() override;
   void analyze( sim_t& ) override;
@@ -4005,7 +4012,7 @@ struct rake_t : public cat_attack_t
 
   std::vector<player_t*>& target_list() const override
   {
-    if ( !target_cache.is_valid )
+    if ( !target_cache_valid() )
       bleed->target_cache.is_valid = false;
 
     auto& tl = cat_attack_t::target_list();
@@ -11431,6 +11438,21 @@ void druid_t::merge( player_t& other )
   eclipse_handler.merge( od.eclipse_handler );
 }
 
+// druid_t::serialize_snapshot ==============================================
+void druid_t::serialize_snapshot( snapshot::archive_t& ar )
+{
+  player_t::serialize_snapshot( ar );
+
+  ar.size( counters.size() );
+  for ( auto& c : counters )
+  {
+    ar.name( c->stats->name_str );
+    c->serialize( ar );
+  }
+
+  eclipse_handler.serialize( ar );
+}
+
 void druid_t::datacollection_begin()
 {
   player_t::datacollection_begin();
@@ -12928,6 +12950,16 @@ void eclipse_handler_t::merge( const eclipse_handler_t& other )
     merge( *other.data.full_moon, *data.full_moon );
 }
 
+void eclipse_handler_t::serialize( snapshot::archive_t& ar )
+{
+  if ( !enabled() ) return;
+
+  // The data pointers point into the arrays, which are only sized on init
+  ar.size( data.arrays.size() );
+  for ( auto& a : data.arrays )
+    ar( a );
+}
+
 void druid_t::copy_from( player_t* source )
 {
   player_t::copy_from( source );
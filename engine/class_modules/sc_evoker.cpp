@@ -473,7 +473,7 @@ struct evoker_t : public player_t
   void schedule_ready( timespan_t, bool ) override;
   // void combat_begin() override;
   // void combat_end() override;
-  void analyze( sim_t& ) override;
+  void pre_analyze_hook() override;
   void reset() override;
   void copy_from( player_t* ) override;
   void merge( player_t& ) override;
@@ -3026,10 +3026,10 @@ struct living_flame_t : public evoker_spell_t
     if ( p()->talent.pupil_of_alexstrasza->ok() )
     {
       // TODO: Auto handle dummy cleave values and damage effectiveness
-      if ( !damage->target_cache.is_valid )
+      if ( !damage->target_cache_valid() )
       {
         damage->available_targets( damage->target_cache.list );
-        damage->target_cache.is_valid = true;
+        damage->validate_target_cache();
       }
 
       if ( damage->target_cache.list.size() > 1 )
@@ -5346,7 +5346,7 @@ void evoker_t::create_options()
   add_option( opt_bool( "evoker.naszuro_accurate_behaviour", option.naszuro_accurate_behaviour ) );
 }
 
-void evoker_t::analyze( sim_t& sim )
+void evoker_t::pre_analyze_hook()
 {
   // For proper DPET analysis, we need to treat empowered spell stat objs as non-channelled so the dot ticks from fire
   // breath do not get summed up into total execute time. All empowered spells have a release spell that is pushed onto
@@ -5358,7 +5358,7 @@ void evoker_t::analyze( sim_t& sim )
       range::for_each( emp->stats->action_list, []( action_t* a ) { a->channeled = false; } );
   }
 
-  player_t::analyze( sim );
+  player_t::pre_analyze_hook();
 }
 
 void evoker_t::moving()
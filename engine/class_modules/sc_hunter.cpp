@@ -146,6 +146,16 @@ struct player_data_t
     }
   }
 
+  void serialize( snapshot::archive_t& ar )
+  {
+    ar.size( data_.size() );
+    for ( auto& rec : data_ )
+    {
+      ar.name( rec.first );
+      ar( rec.second -> exec, rec.second -> cumulative );
+    }
+  }
+
   void datacollection_begin()
   {
     for ( auto& rec : data_ )
@@ -786,6 +796,7 @@ public:
   void      init_special_effects() override;
   void      reset() override;
   void      merge( player_t& other ) override;
+  void      serialize_snapshot( snapshot::archive_t& ar ) override;
   void      arise() override;
   void      combat_begin() override;
 
@@ -1421,6 +1432,7 @@ public:
         if ( it != p -> stats_list.end() )
         {
           p -> stats_list.erase( it );
+          p -> stats_registry.rebuild( p -> stats_list );
           delete ab::stats;
           ab::stats = first_pet -> get_stats( ab::name_str, this );
         }
@@ -6178,7 +6190,7 @@ struct wildfire_bomb_t: public hunter_spell_t
         // Dot applies to all of the same targets hit by the main explosion
         dot_action -> target = target;
         dot_action -> target_cache.list = target_cache.list;
-        dot_action -> target_cache.is_valid = true;
+        dot_action -> validate_target_cache();
         dot_action -> execute();
       }
 
@@ -7633,6 +7645,15 @@ void hunter_t::merge( player_t& other )
   cd_waste.merge( static_cast<hunter_t&>( other ).cd_waste );
 }
 
+// hunter_t::serialize_snapshot =============================================
+
+void hunter_t::serialize_snapshot( snapshot::archive_t& ar )
+{
+  player_t::serialize_snapshot( ar );
+
+  cd_waste.serialize( ar );
+}
+
 void hunter_t::arise()
 {
   player_t::arise();
@@ -184,6 +184,12 @@ struct effect_source_t : private noncopyable
       counts[ i ].merge( other.counts[ i ] );
   }
 
+  void serialize( snapshot::archive_t& ar )
+  {
+    ar.name( name_str );
+    ar( counts );
+  }
+
   void datacollection_begin()
   {
     range::fill( iteration_counts, 0 );
@@ -788,6 +794,7 @@ public:
   void combat_begin() override;
   void copy_from( player_t* ) override;
   void merge( player_t& ) override;
+  void serialize_snapshot( snapshot::archive_t& ) override;
   void analyze( sim_t& ) override;
   void datacollection_begin() override;
   void datacollection_end() override;
@@ -6174,6 +6181,25 @@ void mage_t::merge( player_t& other )
   }
 }
 
+void mage_t::serialize_snapshot( snapshot::archive_t& ar )
+{
+  player_t::serialize_snapshot( ar );
+
+  ar.size( shatter_source_list.size() );
+  for ( auto ss : shatter_source_list )
+    ss->serialize( ar );
+
+  switch ( specialization() )
+  {
+    case MAGE_FROST:
+      if ( talents.thermal_void.ok() )
+        ar( *sample_data.icy_veins_duration );
+      break;
+    default:
+      break;
+  }
+}
+
 void mage_t::analyze( sim_t& s )
 {
   player_t::analyze( s );
@@ -6892,7 +6918,10 @@ void mage_t::init_finished()
 
   // Sort the procs to put the proc sources next to each other.
   if ( specialization() == MAGE_FROST )
+  {
     range::sort( proc_list, [] ( proc_t* a, proc_t* b ) { return a->name_str < b->name_str; } );
+    proc_registry.rebuild( proc_list );
+  }
 }
 
 void mage_t::add_precombat_buff_state( buff_t* buff, int stacks, double value, timespan_t duration )
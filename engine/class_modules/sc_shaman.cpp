@@ -1036,6 +1036,7 @@ public:
   void reset() override;
   void arise() override;
   void merge( player_t& other ) override;
+  void serialize_snapshot( snapshot::archive_t& ar ) override;
   void copy_from( player_t* ) override;
 
   target_specific_t<shaman_td_t> target_data;
@@ -11899,6 +11900,21 @@ void shaman_t::merge( player_t& other )
   }
 }
 
+// shaman_t::serialize_snapshot =============================================
+
+void shaman_t::serialize_snapshot( snapshot::archive_t& ar )
+{
+  player_t::serialize_snapshot( ar );
+
+  // The Maelstrom Weapon lists are indexed by action and filled during combat
+  ar( mw_source_list, mw_spend_list );
+
+  if ( talent.deeply_rooted_elements.ok() )
+  {
+    ar( dre_samples, dre_uptime_samples );
+  }
+}
+
 // shaman_t::primary_role ===================================================
 
 role_e shaman_t::primary_role() const
@@ -958,6 +958,7 @@ public:
   void target_mitigation( school_e, result_amount_type, action_state_t* ) override;
   void copy_from( player_t* ) override;
   void merge( player_t& ) override;
+  void serialize_snapshot( snapshot::archive_t& ) override;
   void apply_affecting_auras( action_t& action ) override;
 
   void datacollection_begin() override;
@@ -9061,6 +9062,20 @@ void warrior_t::merge( player_t& other )
   }
 }
 
+// warrior_t::serialize_snapshot ==============================================
+
+void warrior_t::serialize_snapshot( snapshot::archive_t& ar )
+{
+  player_t::serialize_snapshot( ar );
+
+  ar.size( cd_waste_exec.size() );
+  for ( size_t i = 0, end = cd_waste_exec.size(); i < end; i++ )
+  {
+    ar.name( cd_waste_exec[ i ]->first );
+    ar( cd_waste_exec[ i ]->second, cd_waste_cumulative[ i ]->second );
+  }
+}
+
 // warrior_t::datacollection_begin ===========================================
 
 void warrior_t::datacollection_begin()
@@ -183,6 +183,7 @@ public:
         if ( it != p->stats_list.end() )
         {
           p->stats_list.erase( it );
+          p->stats_registry.rebuild( p->stats_list );
           delete ab::stats;
           ab::stats = first_pet->get_stats( ab::name_str, this );
         }
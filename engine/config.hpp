@@ -161,6 +161,12 @@ constexpr double m_pi = 3.14159265358979323846;
 #define ACTOR_EVENT_BOOKKEEPING
 #endif
 
+// Engine profiler scopes ( profile_engine=1 ), release builds define ENGINE_PROFILER through the
+// SC_ENGINE_PROFILER cmake option
+#if !defined(NDEBUG) && !defined(ENGINE_PROFILER)
+#define ENGINE_PROFILER
+#endif
+
 #define RAPIDJSON_HAS_STDSTRING 1
 
 #if defined(_MSC_VER) && defined(_M_ARM64)
@@ -5,6 +5,7 @@
 #include "util/util.hpp"
 
 #include "active_spells.hpp"
+#include "name_index.hpp"
 
 #include "generated/active_spells.inc"
 #if SC_USE_PTR == 1
@@ -13,20 +14,45 @@
 
 namespace
 {
+template <typename T, typename KeyFn>
+const dbc::name_index_t<T>& __index( bool ptr, KeyFn key )
+{
+  if ( ptr )
+  {
+    static const dbc::name_index_t<T> ptr_index( T::data( true ), key );
+    return ptr_index;
+  }
+
+  static const dbc::name_index_t<T> index( T::data( false ), key );
+  return index;
+}
+
+template <typename T, typename Pred>
+const T* __find( util::string_view name, bool ptr, bool tokenized, Pred pred )
+{
+  if ( tokenized )
+  {
+    const auto& index = __index<T>( ptr, []( const T& e ) { return dbc::tokenized_index_key( e.name ); } );
+    return index.find( T::data( ptr ), dbc::tokenized_index_key( name ), pred );
+  }
+  else
+  {
+    const auto& index = __index<T>( ptr, []( const T& e ) { return dbc::name_index_key( e.name ); } );
+    return index.find( T::data( ptr ), dbc::name_index_key( name ), pred );
+  }
+}
+
 const active_class_spell_t& __find_class( util::string_view name,
                                           bool              ptr,
                                           bool              tokenized,
                                           player_e          class_,
                                           specialization_e  spec )
 {
-  std::string name_str = tokenized ? util::tokenize_fn( name ) : std::string( name );
   unsigned class_id = util::class_id( class_ );
   unsigned spec_id = static_cast<unsigned>( spec );
 
-  const auto __data = active_class_spell_t::data( ptr );
-
-  auto it = range::find_if( __data,
-  [&name_str, tokenized, class_id, spec_id]( const active_class_spell_t& e ) {
+  auto entry = __find<active_class_spell_t>( name, ptr, tokenized,
+  [class_id, spec_id]( const active_class_spell_t& e ) {
     if ( class_id != 0 && e.class_id != class_id )
     {
       return false;
@@ -37,16 +63,10 @@ const active_class_spell_t& __find_class( util::string_view name,
       return false;
     }
 
-    auto str = tokenized ? util::tokenize_fn( e.name ) : e.name;
-    return util::str_compare_ci( name_str, str );
+    return true;
   } );
 
-  if ( it == __data.cend() )
-  {
-    return active_class_spell_t::nil();
-  }
-
-  return *it;
+  return entry ? *entry : active_class_spell_t::nil();
 }
 
 const active_pet_spell_t& __find_pet( util::string_view name,
@@ -54,28 +74,14 @@ const active_pet_spell_t& __find_pet( util::string_view name,
                                       bool              tokenized,
                                       player_e          class_)
 {
-  std::string name_str = tokenized ? util::tokenize_fn( name ) : std::string( name );
   unsigned class_id = util::class_id( class_ );
 
-  const auto __data = active_pet_spell_t::data( ptr );
-
-  auto it = range::find_if( __data,
-  [&name_str, tokenized, class_id]( const active_pet_spell_t& e ) {
-    if ( class_id != 0 && e.owner_class_id != class_id )
-    {
-      return false;
-    }
-
-    auto str = tokenized ? util::tokenize_fn( e.name ) : e.name;
-    return util::str_compare_ci( name_str, str );
+  auto entry = __find<active_pet_spell_t>( name, ptr, tokenized,
+  [class_id]( const active_pet_spell_t& e ) {
+    return class_id == 0 || e.owner_class_id == class_id;
   } );
 
-  if ( it == __data.cend() )
-  {
-    return active_pet_spell_t::nil();
-  }
-
-  return *it;
+  return entry ? *entry : active_pet_spell_t::nil();
 }
 } // Namespace anonymous ends
 
@@ -0,0 +1,91 @@
+// ==========================================================================
+// Dedmonwakeen's Raid DPS/TPS Simulator.
+// Send questions to natehieter@gmail.com
+// ==========================================================================
+#ifndef NAME_INDEX_HPP
+#define NAME_INDEX_HPP
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "util/generic.hpp"
+#include "util/span.hpp"
+#include "util/string_view.hpp"
+#include "util/util.hpp"
+
+namespace dbc
+{
+/* Sorted name index over a client data table, replacing linear scans of the table in name based
+ * lookups. The key of each table entry is computed once, when the index is built. Entries sharing a
+ * key keep the order of the table, so a lookup returns the same entry a linear scan would.
+ *
+ * Client data names do not change at runtime, indices are built on first use and shared by all
+ * threads ( see the function local statics in the lookup functions ).
+ */
+template <typename T>
+class name_index_t
+{
+  struct entry_t
+  {
+    std::string key;
+    size_t      index;
+  };
+
+  std::vector<entry_t> entries;
+
+public:
+  template <typename KeyFn>
+  name_index_t( util::span<const T> data, KeyFn key_fn )
+  {
+    entries.reserve( data.size() );
+    for ( size_t i = 0; i < data.size(); ++i )
+    {
+      entries.push_back( { key_fn( data[ i ] ), i } );
+    }
+
+    std::stable_sort( entries.begin(), entries.end(), []( const entry_t& l, const entry_t& r ) {
+      return l.key < r.key;
+    } );
+  }
+
+  /// First table entry with the given key that satisfies pred, or nullptr
+  template <typename Pred>
+  const T* find( util::span<const T> data, util::string_view key, Pred pred ) const
+  {
+    auto it = std::lower_bound( entries.begin(), entries.end(), key,
+                                []( const entry_t& e, util::string_view k ) { return util::string_view( e.key ) < k; } );
+
+    for ( ; it != entries.end() && it->key == key; ++it )
+    {
+      if ( pred( data[ it->index ] ) )
+      {
+        return &data[ it->index ];
+      }
+    }
+
+    return nullptr;
+  }
+
+  const T* find( util::span<const T> data, util::string_view key ) const
+  { return find( data, key, []( const T& ) { return true; } ); }
+};
+
+/// Index key of case insensitive name lookups
+inline std::string name_index_key( util::string_view name )
+{
+  std::string key( name );
+  util::tolower( key );
+  return key;
+}
+
+/// Index key of case insensitive tokenized name lookups
+inline std::string tokenized_index_key( util::string_view name )
+{
+  std::string key = util::tokenize_fn( name );
+  util::tolower( key );
+  return key;
+}
+} // Namespace dbc ends
+
+#endif /* NAME_INDEX_HPP */
@@ -11,6 +11,7 @@
 #include "dbc/client_data.hpp"
 #include "dbc/dbc.hpp"
 #include "dbc/item_database.hpp"
+#include "dbc/name_index.hpp"
 #include "fmt/format.h"
 #include "item/item.hpp"
 #include "player/player.hpp"
@@ -516,13 +517,26 @@ const spell_data_t* spell_data_t::find( unsigned spell_id, util::string_view con
   return p;
 }
 
+namespace
+{
+const dbc::name_index_t<spell_data_t>& spell_name_index( bool ptr )
+{
+  auto key = []( const spell_data_t& s ) { return std::string( s.name_cstr() ); };
+
+  if ( ptr )
+  {
+    static const dbc::name_index_t<spell_data_t> ptr_index( spell_data_t::data( true ), key );
+    return ptr_index;
+  }
+
+  static const dbc::name_index_t<spell_data_t> index( spell_data_t::data( false ), key );
+  return index;
+}
+} // Namespace anonymous ends
+
 const spell_data_t* spell_data_t::find( util::string_view name, bool ptr )
 {
-  const auto __data = data( ptr );
-  auto it = range::find( __data, name, &spell_data_t::name_cstr );
-  if ( it != __data.end() )
-    return &*it;
-  return nullptr;
+  return spell_name_index( ptr ).find( data( ptr ), name );
 }
 
 const spelleffect_data_t& spell_data_t::find_spelleffect( const spell_data_t& spell, effect_type_t type,
@@ -9,6 +9,7 @@
 #endif
 
 #include "dbc/client_data.hpp"
+#include "dbc/name_index.hpp"
 #include "dbc/spell_data.hpp"
 #include "util/util.hpp"
 
@@ -39,26 +40,42 @@ const talent_data_t* talent_data_t::find( unsigned id, util::string_view confirm
   return p;
 }
 
-const talent_data_t* talent_data_t::find( util::string_view name, specialization_e spec, bool ptr )
+namespace
 {
-  for ( const talent_data_t& td : data( ptr ) )
+template <typename KeyFn>
+const dbc::name_index_t<talent_data_t>& talent_index( bool ptr, KeyFn key )
+{
+  if ( ptr )
   {
-    if ( td.specialization() == spec && name == td.name_cstr() )
-      return &td;
+    static const dbc::name_index_t<talent_data_t> ptr_index( talent_data_t::data( true ), key );
+    return ptr_index;
   }
-  return nullptr;
+
+  static const dbc::name_index_t<talent_data_t> index( talent_data_t::data( false ), key );
+  return index;
 }
 
-const talent_data_t* talent_data_t::find_tokenized( util::string_view name, specialization_e spec, bool ptr )
+const dbc::name_index_t<talent_data_t>& talent_name_index( bool ptr )
 {
-  for ( const talent_data_t& td : data( ptr ) )
-  {
-    auto tokenized_name = util::tokenize_fn( td.name_cstr() );
-    if ( td.specialization() == spec && util::str_compare_ci( name, tokenized_name ) )
-      return &td;
-  }
+  return talent_index( ptr, []( const talent_data_t& td ) { return std::string( td.name_cstr() ); } );
+}
 
-  return nullptr;
+const dbc::name_index_t<talent_data_t>& talent_tokenized_index( bool ptr )
+{
+  return talent_index( ptr, []( const talent_data_t& td ) { return dbc::tokenized_index_key( td.name_cstr() ); } );
+}
+} // Namespace anonymous ends
+
+const talent_data_t* talent_data_t::find( util::string_view name, specialization_e spec, bool ptr )
+{
+  return talent_name_index( ptr ).find( data( ptr ), name,
+      [ spec ]( const talent_data_t& td ) { return td.specialization() == spec; } );
+}
+
+const talent_data_t* talent_data_t::find_tokenized( util::string_view name, specialization_e spec, bool ptr )
+{
+  return talent_tokenized_index( ptr ).find( data( ptr ), dbc::name_index_key( name ),
+      [ spec ]( const talent_data_t& td ) { return td.specialization() == spec; } );
 }
 
 const talent_data_t* talent_data_t::find( player_e c, unsigned int row, unsigned int col, specialization_e spec, bool ptr )
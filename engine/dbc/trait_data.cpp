@@ -9,12 +9,65 @@
 #include "util/util.hpp"
 
 #include "trait_data.hpp"
+#include "name_index.hpp"
 
 #include "generated/trait_data.inc"
 #if SC_USE_PTR == 1
 #include "generated/trait_data_ptr.inc"
 #endif
 
+namespace
+{
+template <typename KeyFn>
+const dbc::name_index_t<trait_data_t>& trait_index( bool ptr, KeyFn key )
+{
+  if ( ptr )
+  {
+    static const dbc::name_index_t<trait_data_t> ptr_index( trait_data_t::data( true ), key );
+    return ptr_index;
+  }
+
+  static const dbc::name_index_t<trait_data_t> index( trait_data_t::data( false ), key );
+  return index;
+}
+
+const trait_data_t* find_trait( talent_tree tree, util::string_view name, unsigned class_id, specialization_e spec,
+                                bool ptr, bool tokenized )
+{
+  auto matches = [ tree, class_id, spec ]( const trait_data_t& entry ) {
+    if ( entry.tree_index != static_cast<unsigned>( tree ) || entry.id_class != class_id )
+    {
+      return false;
+    }
+
+    if ( entry.id_spec[ 0 ] == 0 )
+    {
+      return true;
+    }
+
+    return range::contains( entry.id_spec, static_cast<unsigned>( spec ) );
+  };
+
+  const trait_data_t* trait;
+  if ( tokenized )
+  {
+    const auto& index = trait_index( ptr, []( const trait_data_t& entry ) {
+      return dbc::tokenized_index_key( entry.name );
+    } );
+    trait = index.find( trait_data_t::data( ptr ), dbc::name_index_key( name ), matches );
+  }
+  else
+  {
+    const auto& index = trait_index( ptr, []( const trait_data_t& entry ) {
+      return dbc::name_index_key( entry.name );
+    } );
+    trait = index.find( trait_data_t::data( ptr ), dbc::name_index_key( name ), matches );
+  }
+
+  return trait ? trait : &( trait_data_t::nil() );
+}
+} // Namespace anonymous ends
+
 util::span<const trait_data_t> trait_data_t::data( bool ptr )
 {
   return SC_DBC_GET_DATA( __trait_data_data, __ptr_trait_data_data, ptr );
@@ -57,31 +110,7 @@ const trait_data_t* trait_data_t::find(
     specialization_e  spec,
     bool              ptr )
 {
-  auto _data = data( class_id, tree, ptr );
-  auto _it = range::find_if( _data, [name, spec]( const trait_data_t& entry ) {
-    if ( util::str_compare_ci( name, entry.name ) )
-    {
-      if ( entry.id_spec[ 0 ] == 0 )
-      {
-        return true;
-      }
-
-      auto _spec_it = range::find( entry.id_spec, static_cast<unsigned>( spec ) );
-      if ( _spec_it != entry.id_spec.end() )
-      {
-        return true;
-      }
-    }
-
-    return false;
-  } );
-
-  if ( _it != _data.end() )
-  {
-    return _it;
-  }
-
-  return &( nil() );
+  return find_trait( tree, name, class_id, spec, ptr, false );
 }
 
 const trait_data_t* trait_data_t::find_tokenized(
@@ -91,33 +120,7 @@ const trait_data_t* trait_data_t::find_tokenized(
     specialization_e  spec,
     bool              ptr )
 {
-  auto _data = data( class_id, tree, ptr );
-  auto _it = range::find_if( _data, [name, spec]( const trait_data_t& entry ) {
-    std::string tokenized_name = entry.name;
-    util::tokenize( tokenized_name );
-    if ( util::str_compare_ci( name, tokenized_name ) )
-    {
-      if ( entry.id_spec[ 0 ] == 0 )
-      {
-        return true;
-      }
-
-      auto _spec_it = range::find( entry.id_spec, static_cast<unsigned>( spec ) );
-      if ( _spec_it != entry.id_spec.end() )
-      {
-        return true;
-      }
-    }
-
-    return false;
-  } );
-
-  if ( _it != _data.end() )
-  {
-    return _it;
-  }
-
-  return &( nil() );
+  return find_trait( tree, name, class_id, spec, ptr, true );
 }
 
 std::vector<const trait_data_t*> trait_data_t::find_by_spell(
@@ -225,6 +225,10 @@ public:
   /// Merge dynamic pet information
   void merge( base_actor_spawner_t* other ) override;
 
+  /// Dynamic pets in creation order, for result snapshots
+  size_t n_snapshot_actors() const override;
+  player_t* snapshot_actor( size_t index ) override;
+
   /// Creates persistent pet objects during pet creation
   void create_persistent_actors() override;
 
@@ -560,9 +560,36 @@ void pet_spawner_t<T, O>::merge( base_actor_spawner_t* other )
       continue;
     }
 
-    // Merge other thread pet into this newly created pet
+    // Merge other thread pet into this newly created pet. The placeholder is kept as a pet of this
+    // spawner, so that later merges ( and result snapshots ) see it
     pet -> merge( *o -> m_pets[ n_shared + new_idx ] );
+    m_pets.push_back( pet );
+  }
+}
+
+template <typename T, typename O>
+size_t pet_spawner_t<T, O>::n_snapshot_actors() const
+{
+  // Like merge(), persistent pet spawns are left to the normal merge mechanism
+  return m_type == PET_SPAWN_PERSISTENT ? 0 : n_pets();
+}
+
+template <typename T, typename O>
+player_t* pet_spawner_t<T, O>::snapshot_actor( size_t index )
+{
+  // Snapshots are merged one after the other, placeholders are kept for the next snapshot
+  while ( index >= n_pets() )
+  {
+    T* pet = create_pet( PHASE_MERGE );
+    if ( pet == nullptr )
+    {
+      return nullptr;
+    }
+
+    m_pets.push_back( pet );
   }
+
+  return m_pets[ index ];
 }
 
 template <typename T, typename O>
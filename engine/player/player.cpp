@@ -56,6 +56,7 @@
 #include "sim/proc.hpp"
 #include "sim/real_ppm.hpp"
 #include "sim/cooldown.hpp"
+#include "sim/engine_profiler.hpp"
 #include "sim/expressions.hpp"
 #include "sim/sim.hpp"
 #include "sim/scale_factor_control.hpp"
@@ -5702,6 +5703,7 @@ bool compare( const buff_t* a, const buff_t* b )
 void prepare( player_t& p )
 {
   range::sort( p.buff_list, compare );
+  p.buff_registry.rebuild( p.buff_list );
   // For all i, p.buff_list[ i ] <= p.buff_list[ i + 1 ]
 
 #ifndef NDEBUG
@@ -7934,17 +7936,17 @@ pet_t* player_t::find_pet( util::string_view name ) const
 
 stats_t* player_t::find_stats( util::string_view name ) const
 {
-  return find_vector_member( stats_list, name );
+  return stats_registry.find( stats_list, name );
 }
 
 gain_t* player_t::find_gain( util::string_view name ) const
 {
-  return find_vector_member( gain_list, name );
+  return gain_registry.find( gain_list, name );
 }
 
 proc_t* player_t::find_proc( util::string_view name ) const
 {
-  return find_vector_member( proc_list, name );
+  return proc_registry.find( proc_list, name );
 }
 
 sample_data_helper_t* player_t::find_sample_data( util::string_view name ) const
@@ -7954,7 +7956,7 @@ sample_data_helper_t* player_t::find_sample_data( util::string_view name ) const
 
 benefit_t* player_t::find_benefit( util::string_view name ) const
 {
-  return find_vector_member( benefit_list, name );
+  return benefit_registry.find( benefit_list, name );
 }
 
 uptime_t* player_t::find_uptime( util::string_view name ) const
@@ -7964,7 +7966,7 @@ uptime_t* player_t::find_uptime( util::string_view name ) const
 
 cooldown_t* player_t::find_cooldown( util::string_view name ) const
 {
-  return find_vector_member( cooldown_list, name );
+  return cooldown_registry.find( cooldown_list, name );
 }
 
 target_specific_cooldown_t* player_t::find_target_specific_cooldown( util::string_view name ) const
@@ -7974,7 +7976,8 @@ target_specific_cooldown_t* player_t::find_target_specific_cooldown( util::strin
 
 action_t* player_t::find_action( util::string_view name ) const
 {
-  return find_vector_member( action_list, name );
+  // Actions may be renamed after construction
+  return action_registry.find( action_list, name, true );
 }
 
 cooldown_t* player_t::get_cooldown( util::string_view name, action_t* a )
@@ -7986,6 +7989,7 @@ cooldown_t* player_t::get_cooldown( util::string_view name, action_t* a )
     c = new cooldown_t( name, *this );
 
     cooldown_list.push_back( c );
+    cooldown_registry.add( c );
   }
 
   if ( a )
@@ -8096,6 +8100,7 @@ gain_t* player_t::get_gain( util::string_view name )
     g = new gain_t( name );
 
     gain_list.push_back( g );
+    gain_registry.add( g );
   }
 
   return g;
@@ -8110,6 +8115,7 @@ proc_t* player_t::get_proc( util::string_view name )
     p = new proc_t( *sim, name );
 
     proc_list.push_back( p );
+    proc_registry.add( p );
   }
 
   return p;
@@ -8138,6 +8144,7 @@ stats_t* player_t::get_stats( util::string_view n, action_t* a )
     stats = new stats_t( n, this );
 
     stats_list.push_back( stats );
+    stats_registry.add( stats );
   }
 
   assert( stats->player == this );
@@ -8157,6 +8164,7 @@ benefit_t* player_t::get_benefit( util::string_view name )
     u = new benefit_t( name );
 
     benefit_list.push_back( u );
+    benefit_registry.add( u );
   }
 
   return u;
@@ -11327,6 +11335,12 @@ std::unique_ptr<expr_t> player_t::create_expression( util::string_view expressio
 
         double evaluate() override
         { return var_->current_value_; }
+
+        bool dependencies( expression::dependencies_t& deps ) override
+        {
+          deps.watch( var_->current_value_ );
+          return true;
+        }
       };
 
       return std::make_unique<variable_expr_t>( this, splits[ 1 ] );
@@ -12797,8 +12811,6 @@ void player_t::analyze( sim_t& s )
 {
   assert( s.iterations > 0 );
 
-  pre_analyze_hook();
-
   collected_data.analyze( *this );
 
   range::for_each( buff_list, []( buff_t* b ) { b->analyze(); } );
@@ -12810,6 +12822,8 @@ void player_t::analyze( sim_t& s )
 
   range::sort( stats_list, []( const stats_t* l, const stats_t* r ) { return l->name_str < r->name_str; } );
   range::sort( gain_list, []( const gain_t* l, const gain_t* r ) { return l->name_str < r-> name_str; } );
+  stats_registry.rebuild( stats_list );
+  gain_registry.rebuild( gain_list );
 
   if ( quiet )
     return;
@@ -12876,22 +12890,27 @@ void player_t::analyze( sim_t& s )
 
   // Actor Lists ============================================================
 
-  if ( !quiet && !is_enemy() && !is_add() && !( is_pet() && s.report_pets_separately ) )
+  // Actors are analyzed concurrently, sim_t::analyze() restores the actor order of the lists
   {
-    s.players_by_dps.push_back( this );
-    s.players_by_priority_dps.push_back( this );
-    s.players_by_hps.push_back( this );
-    s.players_by_hps_plus_aps.push_back( this );
-    s.players_by_dtps.push_back( this );
-    s.players_by_tmi.push_back( this );
-    s.players_by_name.push_back( this );
-    s.players_by_apm.push_back( this );
-    s.players_by_variance.push_back( this );
-  }
+    AUTO_LOCK( s.analyze_mutex );
 
-  if ( !quiet && ( is_enemy() || is_add() ) && !( is_pet() && s.report_pets_separately ) )
-  {
-    s.targets_by_name.push_back( this );
+    if ( !quiet && !is_enemy() && !is_add() && !( is_pet() && s.report_pets_separately ) )
+    {
+      s.players_by_dps.push_back( this );
+      s.players_by_priority_dps.push_back( this );
+      s.players_by_hps.push_back( this );
+      s.players_by_hps_plus_aps.push_back( this );
+      s.players_by_dtps.push_back( this );
+      s.players_by_tmi.push_back( this );
+      s.players_by_name.push_back( this );
+      s.players_by_apm.push_back( this );
+      s.players_by_variance.push_back( this );
+    }
+
+    if ( !quiet && ( is_enemy() || is_add() ) && !( is_pet() && s.report_pets_separately ) )
+    {
+      s.targets_by_name.push_back( this );
+    }
   }
 
   // Resources & Gains ======================================================
@@ -13366,6 +13385,19 @@ player_collected_data_t::player_collected_data_t( const player_t* player ) :
 
 void player_collected_data_t::reserve_memory( const player_t& p )
 {
+  // Fight length stays exact, single actor batch sims build the timeline divisor from it
+  if ( p.sim->streaming_sample_data )
+  {
+    for ( auto sd : { &waiting_time, &pooling_time, &executed_foreground_actions, &dmg, &compound_dmg,
+                      &prioritydps, &dps, &dpse, &dtps, &dmg_taken, &heal, &compound_heal, &hps, &hpse,
+                      &htps, &heal_taken, &absorb, &compound_absorb, &aps, &atps, &absorb_taken, &deaths,
+                      &theck_meloree_index, &effective_theck_meloree_index, &max_spike_amount,
+                      &target_metric } )
+    {
+      sd->set_streaming( true );
+    }
+  }
+
   unsigned size = std::min( as<unsigned>( p.sim->iterations ), 2048U );
   fight_length.reserve( size );
   // DMG
@@ -13392,6 +13424,27 @@ void player_collected_data_t::reserve_memory( const player_t& p )
   }
 }
 
+const extended_sample_data_t* player_collected_data_t::metric_sample_data( scale_metric_e metric ) const
+{
+  switch ( metric )
+  {
+    case SCALE_METRIC_DPS:       return &dps;
+    case SCALE_METRIC_DPSE:      return &dpse;
+    case SCALE_METRIC_HPS:       return &hps;
+    case SCALE_METRIC_HPSE:      return &hpse;
+    case SCALE_METRIC_APS:       return &aps;
+    case SCALE_METRIC_DPSP:      return &prioritydps;
+    case SCALE_METRIC_DTPS:      return &dtps;
+    case SCALE_METRIC_DMG_TAKEN: return &dmg_taken;
+    case SCALE_METRIC_HTPS:      return &htps;
+    case SCALE_METRIC_TMI:       return &theck_meloree_index;
+    case SCALE_METRIC_ETMI:      return &effective_theck_meloree_index;
+    case SCALE_METRIC_DEATHS:    return &deaths;
+    case SCALE_METRIC_TIME:      return &fight_length;
+    default:                     return nullptr;
+  }
+}
+
 void player_collected_data_t::merge( const player_t& other_player )
 {
   const auto& other = other_player.collected_data;
@@ -13405,6 +13458,7 @@ void player_collected_data_t::merge( const player_t& other_player )
   total_iterations += other.total_iterations;
 
   fight_length.merge( other.fight_length );
+  iteration_keys.insert( iteration_keys.end(), other.iteration_keys.begin(), other.iteration_keys.end() );
   waiting_time.merge( other.waiting_time );
   executed_foreground_actions.merge( other.executed_foreground_actions );
   // DMG
@@ -13634,6 +13688,10 @@ void player_collected_data_t::collect_data( const player_t& p )
   assert( p.iteration_fight_length <= p.sim->current_time() );
 
   fight_length.add( f_length );
+  if ( p.sim->common_rng )
+  {
+    iteration_keys.push_back( p.sim->iteration_key );
+  }
   waiting_time.add( w_time );
   pooling_time.add( p_time );
 
@@ -13781,6 +13839,20 @@ action_t* player_t::select_action( const action_priority_list_t& list,
                                    execute_type                  type,
                                    const action_t*               context )
 {
+  // Time every TIMING_INTERVAL-th walk of the action priority lists for the compiled expression
+  // statistics. Callers start a walk with no visited lists, the timed walk marks the list visited
+  // and recurses.
+  if ( visited_apls_ == 0 && sim->apl_expression_compiler &&
+       ++sim->apl_expression_stats.selections % expression::compiled_stats_t::TIMING_INTERVAL == 0 )
+  {
+    visited_apls_ = list.internal_id_mask;
+    auto start    = chrono::wall_clock::now();
+    action_t* a   = select_action( list, type, context );
+    sim->apl_expression_stats.timed_seconds += chrono::elapsed_fp_seconds( start );
+    sim->apl_expression_stats.timed_selections++;
+    return a;
+  }
+
   // Mark this action list as visited with the APL internal id
   visited_apls_ |= list.internal_id_mask;
 
@@ -13839,7 +13911,13 @@ action_t* player_t::select_action( const action_priority_list_t& list,
     if ( a->option.wait_on_ready == 1 )
       break;
 
-    if ( a->action_ready() )
+    bool ready;
+    {
+      ENGINE_PROFILER_SCOPE( sim->engine_profiler.get(), engine_profiler_t::APL_LINE, *a );
+      ready = a->action_ready();
+    }
+
+    if ( ready )
     {
       // Execute variable operation, and continue processing
       if ( a->type == ACTION_VARIABLE )
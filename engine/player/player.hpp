@@ -17,6 +17,7 @@
 #include "player_processed_report_information.hpp"
 #include "player_stat_cache.hpp"
 #include "util/cache.hpp"
+#include "util/name_registry.hpp"
 #include "dbc/specialization.hpp"
 #include "assessor.hpp"
 #include "talent.hpp"
@@ -88,6 +89,9 @@ namespace js {
 namespace covenant {
   class covenant_state_t;
 }
+namespace snapshot {
+  class archive_t;
+}
 
 /* Player Report Extension
  * Allows class modules to write extension to the report sections based on the dynamic class of the player.
@@ -357,6 +361,14 @@ struct player_t : public actor_t
   std::vector<std::vector<plot_data_t>> reforge_plot_data;
   auto_dispose<std::vector<sample_data_helper_t*>> sample_data_list;
   std::vector<std::unique_ptr<cooldown_waste_data_t>> cooldown_waste_data_list;
+  // Hashed name lookups of the above lists, see find_buff/find_cooldown/etc.
+  name_registry_t<buff_t> buff_registry;
+  name_registry_t<proc_t> proc_registry;
+  name_registry_t<gain_t> gain_registry;
+  name_registry_t<stats_t> stats_registry;
+  name_registry_t<benefit_t> benefit_registry;
+  name_registry_t<cooldown_t> cooldown_registry;
+  name_registry_t<action_t> action_registry;
 
   // All Data collected during / end of combat
   player_collected_data_t collected_data;
@@ -1003,6 +1015,8 @@ public:
   virtual void combat_end();
   virtual void precombat_init();
   virtual void merge( player_t& other );
+  /// Class module result state that merge() merges, written to and merged from snapshots ( sim/snapshot.hpp )
+  virtual void serialize_snapshot( snapshot::archive_t& ) { }
   virtual void datacollection_begin();
   virtual void datacollection_end();
 
@@ -1225,7 +1239,8 @@ public:
   virtual actor_target_data_t* get_target_data( player_t* /* target */ ) const
   { return nullptr; }
 
-  // Opportunity to perform any stat fixups before analysis
+  // Opportunity to perform any stat fixups before analysis, called for all actors before any of them
+  // ( or their stats ) are analyzed
   virtual void pre_analyze_hook() {}
 
   /* New stuff */
@@ -58,6 +58,10 @@ struct player_collected_data_t
   extended_sample_data_t target_metric;
   mutex_t target_metric_mutex;
 
+  // Iteration keys of the collected samples, in sample order. Only collected with common_rng, pairs
+  // the iterations of compared sims.
+  std::vector<uint64_t> iteration_keys;
+
   std::vector<simple_sample_data_t> resource_lost, resource_gained, resource_overflowed;
   struct resource_timeline_t
   {
@@ -65,6 +69,10 @@ struct player_collected_data_t
     sc_timeline_t timeline;
 
     resource_timeline_t( resource_e t = RESOURCE_NONE ) : type( t ) {}
+
+    template <typename Archive>
+    void serialize( Archive& ar )
+    { ar( type, timeline ); }
   };
   // Druid requires 4 resource timelines health/mana/energy/rage
   std::vector<resource_timeline_t> resource_timelines;
@@ -78,6 +86,10 @@ struct player_collected_data_t
     sc_timeline_t timeline;
 
     stat_timeline_t( stat_e t = STAT_NONE ) : type( t ) {}
+
+    template <typename Archive>
+    void serialize( Archive& ar )
+    { ar( type, timeline ); }
   };
 
   std::vector<stat_timeline_t> stat_timelines;
@@ -170,8 +182,21 @@ struct player_collected_data_t
 
   player_collected_data_t( const player_t* player );
   void reserve_memory( const player_t& );
+  // Per-iteration sample data of a scale metric, nullptr if the metric is not collected as one
+  const extended_sample_data_t* metric_sample_data( scale_metric_e ) const;
   void merge( const player_t& );
   void analyze( const player_t& );
+
+  // Same state as merge()
+  template <typename Archive>
+  void serialize( Archive& ar )
+  {
+    ar( total_iterations, fight_length, iteration_keys, waiting_time, executed_foreground_actions, dmg, compound_dmg,
+        dps, prioritydps, dtps, dpse, dmg_taken, timeline_dmg, heal, compound_heal, hps, htps, hpse, heal_taken,
+        deaths, timeline_dmg_taken, timeline_healing_taken, theck_meloree_index, effective_theck_meloree_index,
+        resource_lost, resource_gained, resource_overflowed, resource_timelines, combat_start_resource,
+        combat_end_resource, stat_timelines, health_changes.merged_timeline, health_changes_tmi.merged_timeline );
+  }
   void collect_data( const player_t& );
   void print_tmi_debug_csv( const sc_timeline_t* nma, const std::vector<double>& weighted_value, const player_t& p );
   double calculate_tmi( const health_changes_timeline_t& tl, int window, double f_length, const player_t& p );
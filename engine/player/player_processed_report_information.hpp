@@ -7,6 +7,7 @@
 
 #include "config.hpp"
 #include "sc_enums.hpp"
+#include "util/concurrency.hpp"
 #include <array>
 #include <string>
 #include <vector>
@@ -26,5 +27,7 @@ struct player_processed_report_information_t
   std::string thumbnail_url;
   std::string html_profile_str;
   std::vector<buff_t*> buff_list, dynamic_buffs, constant_buffs;
+  // The report writers run concurrently, the information is generated by the first writer using it
+  mutex_t mutex;
 
 };
\ No newline at end of file
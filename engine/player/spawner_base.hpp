@@ -51,6 +51,11 @@ namespace spawner
     // Data merging
     virtual void merge(base_actor_spawner_t* other) = 0;
 
+    // Result snapshots: number of actors merged through the spawner, and the index-th of them.
+    // Missing actors are created as merge placeholders.
+    virtual size_t n_snapshot_actors() const = 0;
+    virtual player_t* snapshot_actor(size_t index) = 0;
+
     // Expressions
     virtual std::unique_ptr<expr_t> create_expression(util::span<const util::string_view> expr, util::string_view full_expression_str) = 0;
 
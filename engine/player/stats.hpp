@@ -70,6 +70,10 @@ public:
     void merge( const stats_results_t& other );
     void datacollection_begin();
     void datacollection_end();
+
+    template <typename Archive>
+    void serialize( Archive& ar )
+    { ar( count, fight_total_amount, fight_actual_amount, avg_actual_amount, actual_amount, total_amount, overkill_pct ); }
   };
   std::array<stats_results_t,FULLTYPE_MAX> direct_results;
   std::array<stats_results_t,RESULT_MAX> tick_results;
@@ -105,6 +109,15 @@ public:
   void analyze();
   void merge( const stats_t& other );
   const std::string& name() const { return name_str; }
+
+  // Same state as merge()
+  template <typename Archive>
+  void serialize( Archive& ar )
+  {
+    ar( resource_gain, num_direct_results, num_tick_results, num_executes, num_ticks, num_refreshes,
+        total_execute_time, total_tick_time, total_amount, actual_amount, portion_aps, portion_apse, tick_results,
+        direct_results, timeline_amount );
+  }
   unsigned mask() const { return 1 << type; }
 
   bool has_direct_amount_results() const;
@@ -43,6 +43,7 @@ report_configuration_t::report_configuration_t( std::string version, std::string
     _destination( std::move( destination ) ),
     full_states( false ),
     pretty_print( false ),
+    single_document( false ),
     decimal_places( 0 )
 {
 }
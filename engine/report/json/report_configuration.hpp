@@ -19,6 +19,8 @@ class report_configuration_t
 public:
   bool full_states;
   bool pretty_print;
+  // Build the whole report as a single document before writing it, instead of streaming it
+  bool single_document;
   int decimal_places;
 
   report_configuration_t( std::string version, std::string destination );
@@ -7,7 +7,7 @@
 #include "interfaces/sc_js.hpp"
 #include "player/player_talent_points.hpp"
 #include "report/json/report_configuration.hpp"
-#include "report/report_timer.hpp"
+#include "sim/engine_profiler.hpp"
 #include "sim/scale_factor_control.hpp"
 #include "sim/iteration_data_entry.hpp"
 #include "sim/profileset.hpp"
@@ -215,6 +215,19 @@ void procs_to_json( JsonOutput root, const player_t& p )
   } );
 }
 
+void engine_profile_to_json( JsonOutput root, const engine_profiler_t& profiler )
+{
+  root.make_array();
+  for ( const auto* entry : profiler.sorted_entries() )
+  {
+    auto node = root.add();
+    node[ "category" ] = engine_profiler_t::category_string( entry->category );
+    node[ "name" ] = entry->name;
+    node[ "count" ] = entry->count;
+    node[ "seconds" ] = entry->seconds();
+  }
+}
+
 bool has_valid_stats( const std::vector<stats_t*>& stats_list, int level = 0 )
 {
   return range::any_of( stats_list, [level]( const stats_t* stats ) {
@@ -734,6 +747,19 @@ void scale_deltas_to_json( JsonOutput root, const player_t& p )
   }
 }
 
+void scale_variance_reduction_to_json( JsonOutput root, const player_t& p )
+{
+  auto sm = p.sim -> scaling -> scaling_metric;
+
+  for ( stat_e i = STAT_NONE; i < STAT_MAX; i++ )
+  {
+    if ( p.scaling->scales_with[ i ] )
+    {
+      root[ util::stat_type_abbrev( i ) ] = p.scaling->scaling_variance_reduction[ sm ].get_stat( i );
+    }
+  }
+}
+
 void to_json( JsonOutput& arr, const ::report::json::report_configuration_t& report_configuration, const player_t& p )
 {
   auto root = arr.add(); // Add a fresh object to the players array and use it as root
@@ -835,6 +861,10 @@ void to_json( JsonOutput& arr, const ::report::json::report_configuration_t& rep
     scale_factors_to_json( root[ "scale_factors" ], p );
     scale_factors_all_to_json( root[ "scale_factors_all" ], p );
     scale_deltas_to_json( root[ "scale_deltas" ], p );
+    if ( p.sim -> common_rng )
+    {
+      scale_variance_reduction_to_json( root[ "scale_variance_reduction" ], p );
+    }
   }
 
   collected_data_to_json( root[ "collected_data" ], report_configuration, p );
@@ -1002,6 +1032,22 @@ root[ "metric" ] = util::scale_metric_type_string( sim.profileset_metric.front()
 
     obj[ "iterations" ] = as<uint64_t>( result.iterations() );
 
+    if ( result.paired() )
+    {
+      obj[ "paired_delta" ] = result.paired_delta();
+      obj[ "paired_delta_error" ] = result.paired_delta_stddev() * sim.confidence_estimator;
+      obj[ "variance_reduction" ] = result.variance_reduction();
+    }
+
+    if ( sim.profileset_race_iterations > 0 )
+    {
+      obj[ "total_iterations" ] = as<uint64_t>( profileset -> total_iterations() );
+      if ( profileset -> eliminated() )
+      {
+        obj[ "race_eliminated_round" ] = profileset -> eliminated_round() + 1;
+      }
+    }
+
     if ( profileset -> results() > 1 )
     {
       auto results2 = obj[ "additional_metrics" ].make_array();
@@ -1070,6 +1116,22 @@ void profileset_json3( const profileset::profilesets_t& profilesets, const sim_t
       }
 
       obj[ "iterations" ] = as<uint64_t>( result.iterations() );
+
+      if ( result.paired() )
+      {
+        obj[ "paired_delta" ] = result.paired_delta();
+        obj[ "paired_delta_error" ] = result.paired_delta_stddev() * sim.confidence_estimator;
+        obj[ "variance_reduction" ] = result.variance_reduction();
+      }
+    }
+
+    if ( sim.profileset_race_iterations > 0 )
+    {
+      obj[ "total_iterations" ] = as<uint64_t>( profileset -> total_iterations() );
+      if ( profileset -> eliminated() )
+      {
+        obj[ "race_eliminated_round" ] = profileset -> eliminated_round() + 1;
+      }
     }
     
     // Optional override ouput data
@@ -1097,11 +1159,8 @@ void profileset_json( const ::report::json::report_configuration_t& report_confi
 #endif
 }
 
-void to_json( const ::report::json::report_configuration_t& report_configuration, JsonOutput root, const sim_t& sim )
+void options_to_json( JsonOutput options_root, const sim_t& sim )
 {
-  // Sim-scope options
-  auto options_root = root[ "options" ];
-
   options_root[ "debug" ] = sim.debug;
   options_root[ "max_time" ] = sim.max_time.total_seconds();
   options_root[ "expected_iteration_time" ] = sim.expected_iteration_time.total_seconds();
@@ -1168,9 +1227,10 @@ void to_json( const ::report::json::report_configuration_t& report_configuration
     add_non_zero( scaling_root, "scale_lag", sim.scaling -> scale_lag );
     add_non_zero( scaling_root, "center_scale_delta", sim.scaling -> center_scale_delta );
   }
+}
 
-  // Overrides
-  auto overrides = root[ "overrides" ];
+void overrides_to_json( JsonOutput overrides, const sim_t& sim )
+{
   add_non_zero( overrides, "arcane_intellect", sim.overrides.arcane_intellect );
   add_non_zero( overrides, "battle_shout", sim.overrides.battle_shout );
   add_non_zero( overrides, "power_word_fortitude", sim.overrides.power_word_fortitude );
@@ -1189,49 +1249,229 @@ void to_json( const ::report::json::report_configuration_t& report_configuration
   {
     overrides[ "target_health" ] = sim.overrides.target_health;
   }
+}
 
-  // Players
-  JsonOutput players_arr = root[ "players" ].make_array();
-
-  range::for_each( sim.player_no_pet_list.data(), [ & ]( const player_t* p ) {
-    to_json( players_arr, report_configuration, *p );
-  } );
-
-  if ( sim.profilesets->n_profilesets() > 0 )
-  {
-    auto profileset_root = root[ "profilesets" ];
-    profileset_json( report_configuration, *sim.profilesets, sim, profileset_root );
-  }
-
-  auto stats_root = root[ "statistics" ];
+void statistics_to_json( JsonOutput stats_root, const sim_t& sim )
+{
   stats_root[ "elapsed_cpu_seconds" ] = chrono::to_fp_seconds(sim.elapsed_cpu);
   stats_root[ "elapsed_time_seconds" ] = chrono::to_fp_seconds(sim.elapsed_time);
   stats_root[ "init_time_seconds" ] = chrono::to_fp_seconds(sim.init_time);
+  stats_root[ "startup_time_seconds" ] = chrono::to_fp_seconds(sim.startup_time);
   stats_root[ "merge_time_seconds" ] = chrono::to_fp_seconds(sim.merge_time);
+  if ( !sim.merge_level_time.empty() )
+  {
+    std::vector<double> merge_levels;
+    range::transform( sim.merge_level_time, std::back_inserter( merge_levels ),
+                      []( const auto& t ) { return chrono::to_fp_seconds( t ); } );
+    stats_root[ "merge_level_time_seconds" ] = merge_levels;
+  }
   stats_root[ "analyze_time_seconds" ] = chrono::to_fp_seconds(sim.analyze_time);
+  auto analyze_root = stats_root[ "analyze_phase_time_seconds" ];
+  analyze_root[ "buffs" ] = chrono::to_fp_seconds( sim.analyze_buff_time );
+  analyze_root[ "stats" ] = chrono::to_fp_seconds( sim.analyze_stats_time );
+  analyze_root[ "actors" ] = chrono::to_fp_seconds( sim.analyze_actor_time );
   stats_root[ "simulation_length" ] = sim.simulation_length;
   stats_root[ "total_events_processed" ] = sim.event_mgr.total_events_processed;
+  if ( sim.apl_expression_compiler )
+  {
+    auto expr_root = stats_root[ "apl_expressions" ];
+    expr_root[ "compiled" ] = sim.apl_expression_stats.expressions;
+    expr_root[ "instructions" ] = sim.apl_expression_stats.instructions;
+    expr_root[ "selections" ] = sim.apl_expression_stats.selections;
+    expr_root[ "seconds_per_selection" ] = sim.apl_expression_stats.seconds_per_selection();
+  }
+  if ( sim.apl_readiness_cache )
+  {
+    auto cache_root = stats_root[ "apl_readiness_cache" ];
+    cache_root[ "expressions" ] = sim.apl_readiness_stats.expressions;
+    cache_root[ "lookups" ] = sim.apl_readiness_stats.lookups;
+    cache_root[ "hits" ] = sim.apl_readiness_stats.hits;
+  }
+  if ( sim.engine_profiler )
+  {
+    engine_profile_to_json( stats_root[ "engine_profile" ], *sim.engine_profiler );
+  }
   add_non_zero( stats_root, "raid_dps", sim.raid_dps );
   add_non_zero( stats_root, "raid_hps", sim.raid_hps );
   add_non_zero( stats_root, "raid_aps", sim.raid_aps );
   add_non_zero( stats_root, "total_dmg", sim.total_dmg );
   add_non_zero( stats_root, "total_heal", sim.total_heal );
   add_non_zero( stats_root, "total_absorb", sim.total_absorb );
+}
+
+/**
+ * Streams the report to the output while the sim is traversed. Instead of building the whole report
+ * as one document, each section ( sim options, a single player, statistics, ... ) is built into a
+ * document of its own with the JsonOutput helpers, written and released before the next section is
+ * built. Only the largest section, usually a single player, is held in memory at any time.
+ */
+template <typename Writer>
+class json_stream_t
+{
+  Writer& writer;
+
+  void accept( const Value& v )
+  {
+    if ( !v.Accept( writer ) )
+    {
+      throw std::runtime_error( "JSON Writer did not accept document." );
+    }
+  }
+
+public:
+  json_stream_t( Writer& w ) : writer( w )
+  { }
+
+  void key( util::string_view name )
+  { writer.Key( name.data(), as<SizeType>( name.size() ), true ); }
+
+  void start_object()
+  { writer.StartObject(); }
+
+  void end_object()
+  { writer.EndObject(); }
+
+  void start_array( util::string_view name )
+  { key( name ); writer.StartArray(); }
+
+  void end_array()
+  { writer.EndArray(); }
+
+  // Write an object member of the current object, built by fn into a document of its own
+  template <typename Fn>
+  void member( util::string_view name, Fn&& fn )
+  {
+    Document doc;
+    doc.SetObject();
+    fn( JsonOutput( doc, doc ) );
+    key( name );
+    accept( doc );
+  }
+
+  template <typename T>
+  void value( util::string_view name, const T& v )
+  { member( name, [ &v ]( JsonOutput root ) { root = v; } ); }
+
+  // Write the values fn appends to a JSON array into the current array
+  template <typename Fn>
+  void elements( Fn&& fn )
+  {
+    Document doc;
+    doc.SetArray();
+    JsonOutput arr( doc, doc );
+    fn( arr );
+    for ( auto it = doc.Begin(); it != doc.End(); ++it )
+    {
+      accept( *it );
+    }
+  }
+};
+
+template <typename Writer>
+void to_json( const ::report::json::report_configuration_t& report_configuration, json_stream_t<Writer>& out, const sim_t& sim )
+{
+  out.member( "options", [ & ]( JsonOutput root ) { options_to_json( root, sim ); } );
+  out.member( "overrides", [ & ]( JsonOutput root ) { overrides_to_json( root, sim ); } );
+
+  // Players, one at a time
+  out.start_array( "players" );
+  range::for_each( sim.player_no_pet_list.data(), [ & ]( const player_t* p ) {
+    out.elements( [ & ]( JsonOutput arr ) { to_json( arr, report_configuration, *p ); } );
+  } );
+  out.end_array();
+
+  if ( sim.profilesets->n_profilesets() > 0 )
+  {
+    out.member( "profilesets", [ & ]( JsonOutput root ) {
+      profileset_json( report_configuration, *sim.profilesets, sim, root );
+    } );
+  }
+
+  out.member( "statistics", [ & ]( JsonOutput root ) { statistics_to_json( root, sim ); } );
 
   if ( sim.report_details != 0 )
   {
     // Targets
-    JsonOutput targets_arr = root[ "targets" ].make_array();
+    out.start_array( "targets" );
+    range::for_each( sim.target_list.data(), [ & ]( const player_t* p ) {
+      out.elements( [ & ]( JsonOutput arr ) { to_json( arr, report_configuration, *p ); } );
+    } );
+    out.end_array();
 
+    // Raid events
+    if ( ! sim.raid_events.empty() )
+    {
+      out.start_array( "raid_events" );
+      out.elements( [ & ]( JsonOutput arr ) {
+        range::for_each( sim.raid_events, [ & ]( const std::unique_ptr<raid_event_t>& event ) {
+          to_json( arr, *event );
+        } );
+      } );
+      out.end_array();
+    }
+
+    if ( !sim.buff_list.empty() )
+    {
+      out.start_array( "sim_auras" );
+      range::for_each( sim.buff_list, [ & ]( const buff_t* b ) {
+        if ( b -> avg_start.mean() == 0 )
+        {
+          return;
+        }
+        out.elements( [ & ]( JsonOutput arr ) { to_json( arr.add(), b ); } );
+      } );
+      out.end_array();
+    }
+
+    if ( !sim.low_iteration_data.empty() || !sim.high_iteration_data.empty() )
+    {
+      out.member( "iteration_data", [ & ]( JsonOutput root ) {
+        if ( !sim.low_iteration_data.empty() )
+        {
+          iteration_data_to_json( root[ "low" ], sim.low_iteration_data );
+        }
+
+        if ( !sim.high_iteration_data.empty() )
+        {
+          iteration_data_to_json( root[ "high" ], sim.high_iteration_data );
+        }
+      } );
+    }
+  }
+}
+
+/**
+ * The whole report built as a single document before it is written, the report writer before the
+ * report was streamed. Only used to check that the streamed report is identical ( json=...,document=1 ).
+ */
+void to_json( const ::report::json::report_configuration_t& report_configuration, JsonOutput root, const sim_t& sim )
+{
+  options_to_json( root[ "options" ], sim );
+  overrides_to_json( root[ "overrides" ], sim );
+
+  JsonOutput players_arr = root[ "players" ].make_array();
+  range::for_each( sim.player_no_pet_list.data(), [ & ]( const player_t* p ) {
+    to_json( players_arr, report_configuration, *p );
+  } );
+
+  if ( sim.profilesets->n_profilesets() > 0 )
+  {
+    auto profileset_root = root[ "profilesets" ];
+    profileset_json( report_configuration, *sim.profilesets, sim, profileset_root );
+  }
+
+  statistics_to_json( root[ "statistics" ], sim );
+
+  if ( sim.report_details != 0 )
+  {
+    JsonOutput targets_arr = root[ "targets" ].make_array();
     range::for_each( sim.target_list.data(), [ & ]( const player_t* p ) {
       to_json( targets_arr, report_configuration, *p );
     } );
 
-    // Raid events
     if ( ! sim.raid_events.empty() )
     {
       auto arr = root[ "raid_events" ].make_array();
-
       range::for_each( sim.raid_events, [ & ]( const std::unique_ptr<raid_event_t>& event ) {
         to_json( arr, *event );
       } );
@@ -1261,36 +1501,14 @@ void to_json( const ::report::json::report_configuration_t& report_configuration
   }
 }
 
-void normal_print(FileWriteStream& stream, Document& doc, const ::report::json::report_configuration_t& report_configuration  )
+template <typename Writer>
+void print_json_document( Writer& writer, const sim_t& sim, const ::report::json::report_configuration_t& report_configuration )
 {
-  Writer<FileWriteStream> writer( stream );
-  if (report_configuration.decimal_places > 0)
+  if ( report_configuration.decimal_places > 0 )
   {
-    writer.SetMaxDecimalPlaces(report_configuration.decimal_places);
+    writer.SetMaxDecimalPlaces( report_configuration.decimal_places );
   }
-  auto accepted = doc.Accept( writer );
-  if ( !accepted )
-  {
-    throw std::runtime_error("JSON Writer did not accept document.");
-  }
-}
 
-void pretty_print(FileWriteStream& stream, Document& doc, const ::report::json::report_configuration_t& report_configuration  )
-{
-  PrettyWriter<FileWriteStream> writer( stream );
-  if (report_configuration.decimal_places > 0)
-  {
-    writer.SetMaxDecimalPlaces(report_configuration.decimal_places);
-  }
-  auto accepted = doc.Accept( writer );
-  if ( !accepted )
-  {
-    throw std::runtime_error("JSON Writer did not accept document.");
-  }
-}
-
-void print_json_pretty( FILE* o, const sim_t& sim, const ::report::json::report_configuration_t& report_configuration )
-{
   Document doc;
   Value& v = doc;
   v.SetObject();
@@ -1321,22 +1539,91 @@ void print_json_pretty( FILE* o, const sim_t& sim, const ::report::json::report_
 
   to_json( report_configuration, root[ "sim" ], sim );
 
-  if ( !sim.error_list.empty() )
+  auto errors = sim.errors();
+  if ( !errors.empty() )
+  {
+    root[ "notifications" ] = errors;
+  }
+
+  if ( !doc.Accept( writer ) )
+  {
+    throw std::runtime_error("JSON Writer did not accept document.");
+  }
+}
+
+template <typename Writer>
+void print_json_stream( Writer& writer, const sim_t& sim, const ::report::json::report_configuration_t& report_configuration )
+{
+  if ( report_configuration.decimal_places > 0 )
+  {
+    writer.SetMaxDecimalPlaces( report_configuration.decimal_places );
+  }
+
+  json_stream_t<Writer> out( writer );
+
+  out.start_object();
+
+  if (report_configuration.version_intersects(">=3.0.0"))
+  {
+    out.value( "$id", fmt::format("https://www.simulationcraft.org/reports/{}.schema.json", report_configuration.version()) );
+  }
+  out.value( "version", SC_VERSION );
+  out.value( "report_version", report_configuration.version() );
+  out.value( "ptr_enabled", SC_USE_PTR );
+  out.value( "beta_enabled", SC_BETA );
+  out.value( "build_date", __DATE__ );
+  out.value( "build_time", __TIME__ );
+  out.value( "timestamp", as<uint64_t>( std::time( nullptr ) ) );
+  if constexpr ( SC_NO_NETWORKING_ON )
+  {
+    out.value( "no_networking", true );
+  }
+
+  if ( git_info::available())
+  {
+    out.value( "git_revision", git_info::revision() );
+    out.value( "git_branch", git_info::branch() );
+  }
+
+  out.key( "sim" );
+  out.start_object();
+  to_json( report_configuration, out, sim );
+  out.end_object();
+
+  auto errors = sim.errors();
+  if ( !errors.empty() )
   {
-    root[ "notifications" ] = sim.error_list;
+    out.value( "notifications", errors );
   }
 
+  out.end_object();
+
+  if ( !writer.IsComplete() )
+  {
+    throw std::runtime_error("JSON Writer did not accept document.");
+  }
+}
+
+void print_json_pretty( FILE* o, const sim_t& sim, const ::report::json::report_configuration_t& report_configuration )
+{
   std::array<char, 16384> buffer;
   FileWriteStream b( o, buffer.data(), buffer.size() );
-  if (report_configuration.pretty_print)
+  if ( report_configuration.pretty_print )
   {
-    pretty_print(b, doc, report_configuration);
+    PrettyWriter<FileWriteStream> writer( b );
+    if ( report_configuration.single_document )
+      print_json_document( writer, sim, report_configuration );
+    else
+      print_json_stream( writer, sim, report_configuration );
   }
   else
   {
-    normal_print(b, doc, report_configuration);
+    Writer<FileWriteStream> writer( b );
+    if ( report_configuration.single_document )
+      print_json_document( writer, sim, report_configuration );
+    else
+      print_json_stream( writer, sim, report_configuration );
   }
-  
 }
 
 void print_json_report( sim_t& sim, const ::report::json::report_configuration_t& report_configuration)
@@ -1359,11 +1646,6 @@ void print_json_report( sim_t& sim, const ::report::json::report_configuration_t
       {
         fmt::print( "\nReport will be generated with full state for each action.\n" );
       }
-      report_timer_t t( fmt::format( "JSON report version {}", report_configuration.version() ), stdout );
-      if ( ! sim.profileset_enabled )
-      {
-        t.start();
-      }
       print_json_pretty( s, sim, report_configuration );
     }
     catch ( const std::exception& e )
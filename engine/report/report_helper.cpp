@@ -571,6 +571,8 @@ bool report_helper::check_gear( player_t& p, sim_t& sim )
 
 void report_helper::generate_player_buff_lists( player_t& p, player_processed_report_information_t& ri )
 {
+  AUTO_LOCK( ri.mutex );
+
   if ( ri.buff_lists_generated )
     return;
 
@@ -601,6 +603,8 @@ void report_helper::generate_player_buff_lists( player_t& p, player_processed_re
 
 void report_helper::generate_player_charts( player_t& p, player_processed_report_information_t& ri )
 {
+  AUTO_LOCK( ri.mutex );
+
   if ( ri.generated )
     return;
 
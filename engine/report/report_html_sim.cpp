@@ -6,17 +6,19 @@
 #include "simulationcraft.hpp"
 #include "reports.hpp"
 #include "report/report_helper.hpp"
-#include "report/report_timer.hpp"
 #include "report/charts.hpp"
 #include "report/highchart.hpp"
 #include "data/report_data.inc"
 #include "interfaces/sc_js.hpp"
 #include "util/git_info.hpp"
+#include "sim/engine_profiler.hpp"
 #include "sim/scale_factor_control.hpp"
 #include "sim/profileset.hpp"
 #include "fmt/chrono.h"
 
 #include <iostream>
+#include <memory>
+#include <sstream>
 
 namespace
 {  // UNNAMED NAMESPACE ==========================================
@@ -538,6 +540,63 @@ void print_html_sim_summary( report::sc_html_stream& os, sim_t& sim )
      << "</div>\n\n";
 }
 
+// print_html_engine_profile ================================================
+
+void print_html_engine_profile( report::sc_html_stream& os, const sim_t& sim )
+{
+  if ( !sim.engine_profiler )
+    return;
+
+  const auto& profiler = *sim.engine_profiler;
+
+  os << "<div id=\"engine-profile\" class=\"section\">\n"
+     << "<h2 class=\"toggle\">Engine Profile</h2>\n"
+     << "<div class=\"toggle-content hide\">\n";
+
+  os << "<p>Wall clock time of event executions, engine dispatched action executes, impacts and ticks, "
+     << "and APL line readiness checks, summed over all threads. Times are inclusive.</p>\n";
+
+  os << "<table class=\"sc sort even\">\n"
+     << "<thead>\n"
+     << "<tr>\n"
+     << "<th class=\"toggle-sort left\" data-sortdir=\"asc\" data-sorttype=\"alpha\">Category</th>\n"
+     << "<th class=\"toggle-sort left\" data-sortdir=\"asc\" data-sorttype=\"alpha\">Name</th>\n"
+     << "<th class=\"toggle-sort\">Count</th>\n"
+     << "<th class=\"toggle-sort\">Time (s)</th>\n"
+     << "<th class=\"toggle-sort\">Category%</th>\n"
+     << "<th class=\"toggle-sort\">Avg (ns)</th>\n"
+     << "</tr>\n"
+     << "</thead>\n"
+     << "<tbody>\n";
+
+  std::array<double, engine_profiler_t::CATEGORY_MAX> category_total;
+  for ( unsigned i = 0; i < category_total.size(); ++i )
+  {
+    category_total[ i ] = profiler.category_seconds( static_cast<engine_profiler_t::category_e>( i ) );
+  }
+
+  for ( const auto* entry : profiler.sorted_entries() )
+  {
+    double total = category_total[ entry->category ];
+    os.format( "<tr>\n"
+               "<td class=\"left\">{}</td>\n"
+               "<td class=\"left\">{}</td>\n"
+               "<td>{}</td>\n"
+               "<td>{:.4f}</td>\n"
+               "<td>{:.2f}%</td>\n"
+               "<td>{:.0f}</td>\n"
+               "</tr>\n",
+               engine_profiler_t::category_string( entry->category ), util::encode_html( entry->name ),
+               entry->count, entry->seconds(), total > 0 ? 100.0 * entry->seconds() / total : 0.0,
+               1e9 * entry->seconds() / entry->count );
+  }
+
+  os << "</tbody>\n"
+     << "</table>\n"
+     << "</div>\n"
+     << "</div>\n\n";
+}
+
 // print_html_raid_summary ==================================================
 
 void print_html_raid_summary( report::sc_html_stream& os, sim_t& sim )
@@ -1045,11 +1104,12 @@ void print_html_masthead( report::sc_html_stream& os, const sim_t& sim )
 
 void print_html_errors( report::sc_html_stream& os, const sim_t& sim )
 {
-  if ( !sim.error_list.empty() )
+  auto errors = sim.errors();
+  if ( !errors.empty() )
   {
     os << "<pre class=\"section section-open\" style=\"color: black; background-color: white; font-weight: bold;\">\n";
 
-    for ( const auto& error : sim.error_list )
+    for ( const auto& error : errors )
       os << util::encode_html( error ) << "\n";
 
     os << "</pre>\n\n";
@@ -1354,6 +1414,67 @@ void print_profilesets( std::ostream& out, const profileset::profilesets_t& prof
   out << "</div>";
 }
 
+/* Print the sections of the actors, and of their pets if reported separately. The sections of each
+ * actor are rendered concurrently into buffers, which are written to the report in actor order. The
+ * chart data of the sections is added to the sim in the same order, so the report is identical to
+ * rendering the sections one after another. A section evaluates the state ( stat cache, composites,
+ * buffs ) of its actor and the actor's pets only, and no other report writer runs concurrently with
+ * the html report, see report::print_suite.
+ */
+void print_html_actors( report::sc_html_stream& os, sim_t& sim, const std::vector<player_t*>& actors,
+                        bool summoned_pets_only )
+{
+  struct section_t
+  {
+    player_t* actor;
+    std::stringbuf buffer;
+    sim_t::chart_data_buffer_t chart_data;
+  };
+
+  std::vector<std::unique_ptr<section_t>> sections;
+  for ( auto* actor : actors )
+  {
+    sections.push_back( std::make_unique<section_t>() );
+    sections.back()->actor = actor;
+  }
+
+  auto render = [ &os, &sim, summoned_pets_only ]( const std::unique_ptr<section_t>& section ) {
+    report::sc_html_stream section_os;
+    static_cast<std::ostream&>( section_os ).rdbuf( &section->buffer );
+    section_os.copyfmt( os );
+
+    sim_t::buffer_chart_data( &section->chart_data );
+    try
+    {
+      report::print_html_player( section_os, *section->actor );
+
+      // Pets
+      if ( sim.report_pets_separately )
+      {
+        for ( auto& pet : section->actor->pet_list )
+        {
+          if ( !summoned_pets_only || ( pet->summoned && !pet->quiet ) )
+            report::print_html_player( section_os, *pet );
+        }
+      }
+    }
+    catch ( ... )
+    {
+      sim_t::buffer_chart_data( nullptr );
+      throw;
+    }
+    sim_t::buffer_chart_data( nullptr );
+  };
+
+  thread::parallel_for_each( sections, sim.threads, render );
+
+  for ( const auto& section : sections )
+  {
+    os << section->buffer.str();
+    sim.add_chart_data( section->chart_data );
+  }
+}
+
 /* Main function building the html document and calling subfunctions
  */
 void print_html_( report::sc_html_stream& os, sim_t& sim )
@@ -1408,43 +1529,19 @@ void print_html_( report::sc_html_stream& os, sim_t& sim )
   print_profilesets( os, *sim.profilesets, sim );
 
   // Report Players
-  for ( auto& player : sim.players_by_name )
-  {
-    report::print_html_player( os, *player );
-
-    // Pets
-    if ( sim.report_pets_separately )
-    {
-      for ( auto& pet : player->pet_list )
-      {
-        if ( pet->summoned && !pet->quiet )
-          report::print_html_player( os, *pet );
-      }
-    }
-  }
+  print_html_actors( os, sim, sim.players_by_name, true );
 
   print_html_sim_summary( os, sim );
 
+  print_html_engine_profile( os, sim );
+
   if ( sim.report_raw_abilities )
     raw_ability_summary::print( os, sim );
 
   // Report Targets
   if ( sim.report_targets )
   {
-    for ( auto& player : sim.targets_by_name )
-    {
-      report::print_html_player( os, *player );
-
-      // Pets
-      if ( sim.report_pets_separately )
-      {
-        for ( auto& pet : player->pet_list )
-        {
-          // if ( pet -> summoned )
-          report::print_html_player( os, *pet );
-        }
-      }
-    }
+    print_html_actors( os, sim, sim.targets_by_name, false );
   }
 
   print_html_help_boxes( os, sim );
@@ -1520,12 +1617,6 @@ void print_html( sim_t& sim )
   if ( sim.html_file_str.empty() )
     return;
 
-  report_timer_t t( "html report", stdout );
-  if ( ! sim.profileset_enabled )
-  {
-    t.start();
-  }
-
   // Setup file stream and open file
   report::sc_html_stream s;
   s.open( sim.html_file_str );
@@ -0,0 +1,154 @@
+// ==========================================================================
+// Dedmonwakeen's Raid DPS/TPS Simulator.
+// Send questions to natehieter@gmail.com
+// ==========================================================================
+
+#include "reports.hpp"
+
+#include "player/player.hpp"
+#include "sim/sim.hpp"
+#include "util/io.hpp"
+#include "util/results_binary.hpp"
+
+#include <array>
+#include <cstring>
+#include <stdexcept>
+
+namespace
+{
+struct column_source_t
+{
+  std::string actor;
+  std::string metric;
+  const std::vector<double>* rows;
+};
+
+void add_column( std::vector<column_source_t>& columns, util::string_view actor, util::string_view metric,
+                 const extended_sample_data_t& data )
+{
+  // Only containers that store their samples have per iteration data
+  if ( data.simple || data.streaming() || data.data().empty() )
+  {
+    return;
+  }
+
+  columns.push_back( { std::string( actor ), std::string( metric ), &data.data() } );
+}
+
+std::vector<column_source_t> results_columns( const sim_t& sim )
+{
+  std::vector<column_source_t> columns;
+
+  add_column( columns, "", "raid_dps", sim.raid_dps );
+  add_column( columns, "", "simulation_length", sim.simulation_length );
+
+  for ( const player_t* p : sim.player_list )
+  {
+    const auto& cd = p->collected_data;
+
+    add_column( columns, p->name_str, "fight_length", cd.fight_length );
+    add_column( columns, p->name_str, "dmg", cd.dmg );
+    add_column( columns, p->name_str, "compound_dmg", cd.compound_dmg );
+    add_column( columns, p->name_str, "dps", cd.dps );
+    add_column( columns, p->name_str, "prioritydps", cd.prioritydps );
+    add_column( columns, p->name_str, "dpse", cd.dpse );
+    add_column( columns, p->name_str, "heal", cd.heal );
+    add_column( columns, p->name_str, "compound_heal", cd.compound_heal );
+    add_column( columns, p->name_str, "hps", cd.hps );
+    add_column( columns, p->name_str, "absorb", cd.absorb );
+    add_column( columns, p->name_str, "aps", cd.aps );
+    add_column( columns, p->name_str, "dmg_taken", cd.dmg_taken );
+    add_column( columns, p->name_str, "dtps", cd.dtps );
+    add_column( columns, p->name_str, "heal_taken", cd.heal_taken );
+    add_column( columns, p->name_str, "htps", cd.htps );
+    add_column( columns, p->name_str, "theck_meloree_index", cd.theck_meloree_index );
+    add_column( columns, p->name_str, "effective_theck_meloree_index", cd.effective_theck_meloree_index );
+    add_column( columns, p->name_str, "max_spike_amount", cd.max_spike_amount );
+    add_column( columns, p->name_str, "target_metric", cd.target_metric );
+    // One row per death, the time of death in seconds
+    add_column( columns, p->name_str, "death_time", cd.deaths );
+  }
+
+  return columns;
+}
+
+void write( FILE* file, const void* data, size_t size )
+{
+  if ( size > 0 && std::fwrite( data, size, 1, file ) != 1 )
+  {
+    throw std::runtime_error( "Unable to write results" );
+  }
+}
+
+void write_results( FILE* file, const sim_t& sim )
+{
+  using namespace results_binary;
+
+  auto columns = results_columns( sim );
+
+  std::string strings;
+  std::vector<column_entry_t> directory;
+  for ( const auto& column : columns )
+  {
+    column_entry_t entry {};
+    entry.actor_offset = as<uint32_t>( strings.size() );
+    entry.actor_length = as<uint32_t>( column.actor.size() );
+    strings += column.actor;
+    entry.metric_offset = as<uint32_t>( strings.size() );
+    entry.metric_length = as<uint32_t>( column.metric.size() );
+    strings += column.metric;
+    entry.row_count = column.rows->size();
+    directory.push_back( entry );
+  }
+
+  header_t header {};
+  std::memcpy( header.magic, MAGIC, sizeof( MAGIC ) );
+  header.format_version      = FORMAT_VERSION;
+  header.column_count        = as<uint32_t>( columns.size() );
+  header.iterations          = sim.simulation_length.count();
+  header.string_table_offset = sizeof( header_t ) + directory.size() * sizeof( column_entry_t );
+
+  uint64_t offset = header.string_table_offset + strings.size();
+  for ( auto& entry : directory )
+  {
+    offset = ( offset + ALIGNMENT - 1 ) / ALIGNMENT * ALIGNMENT;
+    entry.offset = offset;
+    offset += entry.row_count * sizeof( double );
+  }
+
+  write( file, &header, sizeof( header ) );
+  write( file, directory.data(), directory.size() * sizeof( column_entry_t ) );
+  write( file, strings.data(), strings.size() );
+
+  std::array<char, ALIGNMENT> padding {};
+  offset = header.string_table_offset + strings.size();
+  for ( size_t i = 0; i < columns.size(); ++i )
+  {
+    write( file, padding.data(), directory[ i ].offset - offset );
+    write( file, columns[ i ].rows->data(), columns[ i ].rows->size() * sizeof( double ) );
+    offset = directory[ i ].offset + directory[ i ].row_count * sizeof( double );
+  }
+}
+}  // unnamed namespace
+
+namespace report
+{
+void print_results_binary( sim_t& sim )
+{
+  io::cfile file( sim.results_binary_file_str, "wb" );
+  if ( !file )
+  {
+    sim.error( "Failed to open results output file '{}'.", sim.results_binary_file_str );
+    return;
+  }
+
+  try
+  {
+    write_results( file, sim );
+  }
+  catch ( const std::exception& e )
+  {
+    sim.error( "Error generating binary results: {}", e.what() );
+  }
+}
+}  // namespace report
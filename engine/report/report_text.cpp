@@ -6,7 +6,6 @@
 #include "simulationcraft.hpp"
 #include "player/covenant.hpp"
 #include "reports.hpp"
-#include "report/report_timer.hpp"
 #include "sim/scale_factor_control.hpp"
 #include "sim/iteration_data_entry.hpp"
 #include "sim/plot.hpp"
@@ -743,6 +742,15 @@ void sim_summary_performance( std::ostream& os, sim_t* sim )
   if ( sim -> threads > 1 )
     iterations_str = fmt::format( " ({})", fmt::join( sim -> work_per_thread, ", " ) );
 
+  std::string merge_levels_str;
+  if ( !sim->merge_level_time.empty() )
+  {
+    std::vector<double> levels;
+    range::transform( sim->merge_level_time, std::back_inserter( levels ),
+                      []( const auto& t ) { return chrono::to_fp_seconds( t ); } );
+    merge_levels_str = fmt::format( " (per level: {:.3f})", fmt::join( levels, ", " ) );
+  }
+
   fmt::print(
       os,
       "\n\nBaseline Performance:\n"
@@ -751,19 +759,23 @@ void sim_summary_performance( std::ostream& os, sim_t* sim )
       "  Iterations    = {}{}\n"
       "  TotalEvents   = {}\n"
       "  MaxEventQueue = {}\n"
+      "  EventQueue    = {}\n"
 #ifdef EVENT_QUEUE_DEBUG
       "  AllocEvents   = {}\n"
       "  EndInsert     = {} ({:.3f}%)\n"
       "  MaxTravDepth  = {}\n"
       "  AvgTravDepth  = {}\n"
+      "  InsertCost    = {:.1f}ns/event\n"
+      "  PopCost       = {:.1f}ns/event\n"
 #endif
       "  TargetHealth  = {:.0f}\n"
       "  SimSeconds    = {:.3f}\n"
       "  CpuSeconds    = {}\n"
       "  WallSeconds   = {}\n"
       "  InitSeconds   = {}\n"
-      "  MergeSeconds  = {}\n"
-      "  AnalyzeSeconds= {}\n"
+      "  StartupSeconds= {}\n"
+      "  MergeSeconds  = {}{}\n"
+      "  AnalyzeSeconds= {} (buffs: {:.3f}, stats: {:.3f}, actors: {:.3f})\n"
       "  SpeedUp       = {:.0f}\n"
       "  EndTime       = {:%Y-%m-%d %H:%M:%S%z} ({})\n\n",
       SC_NO_NETWORKING_ON ? "disabled" : "enabled",
@@ -772,6 +784,7 @@ void sim_summary_performance( std::ostream& os, sim_t* sim )
       sim -> threads > 1 ? iterations_str : "",
       sim->event_mgr.total_events_processed,
       sim->event_mgr.max_events_remaining,
+      sim->event_mgr.queue_type_str(),
 #ifdef EVENT_QUEUE_DEBUG
       sim->event_mgr.n_allocated_events, sim->event_mgr.n_end_insert,
       100.0 * static_cast<double>( sim->event_mgr.n_end_insert ) /
@@ -779,15 +792,37 @@ void sim_summary_performance( std::ostream& os, sim_t* sim )
       sim->event_mgr.max_queue_depth,
       static_cast<double>( sim->event_mgr.events_traversed ) /
           sim->event_mgr.events_added,
+      1e9 * chrono::to_fp_seconds( sim->event_mgr.insert_time ) / sim->event_mgr.events_added,
+      1e9 * chrono::to_fp_seconds( sim->event_mgr.pop_time ) / sim->event_mgr.total_events_processed,
 #endif
       sim->target->resources.base[ RESOURCE_HEALTH ],
       sim->simulation_length.sum(), chrono::to_fp_seconds(sim->elapsed_cpu),
       chrono::to_fp_seconds(sim->elapsed_time),
       chrono::to_fp_seconds(sim->init_time),
+      chrono::to_fp_seconds(sim->startup_time),
       chrono::to_fp_seconds(sim->merge_time),
+      merge_levels_str,
       chrono::to_fp_seconds(sim->analyze_time),
+      chrono::to_fp_seconds( sim->analyze_buff_time ),
+      chrono::to_fp_seconds( sim->analyze_stats_time ),
+      chrono::to_fp_seconds( sim->analyze_actor_time ),
       sim->iterations * sim->simulation_length.mean() / chrono::to_fp_seconds(sim->elapsed_cpu),
       fmt::localtime(cur_time), cur_time );
+
+  if ( sim->apl_expression_compiler )
+  {
+    const auto& es = sim->apl_expression_stats;
+    fmt::print( os, "  Compiled APL Expressions = {} ({} instructions)\n"
+                    "  APL Action Selections    = {} ({:.2f}us/selection)\n\n",
+                es.expressions, es.instructions, es.selections, es.seconds_per_selection() * 1e6 );
+  }
+
+  if ( sim->apl_readiness_cache )
+  {
+    const auto& rs = sim->apl_readiness_stats;
+    fmt::print( os, "  Cached APL Conditions = {} ({} lookups, {:.1f}% reused)\n\n",
+                rs.expressions, rs.lookups, 100.0 * rs.hit_rate() );
+  }
 #ifdef EVENT_QUEUE_DEBUG
   double total_p = 0;
 
@@ -836,8 +871,9 @@ void sim_summary_performance( std::ostream& os, sim_t* sim )
   fmt::print( os, "Total: {:.3f}% Alloc Samples: {}\n",
       total_p,
       sim->event_mgr.n_requested_events );
-  fmt::print( os, "Alloc size used for event_t: {}\n",
-      util::next_power_of_two( 2 * sizeof( event_t ) ) );
+  fmt::print( os, "Alloc size used for event_t: {} (event memory reserved: {} bytes)\n",
+      sim->event_mgr.event_allocator.block_size( sizeof( event_t ) ),
+      sim->event_mgr.event_allocator.reserved_bytes() );
 #endif
 }
 
@@ -937,6 +973,21 @@ void print_player_scale_factors( std::ostream& os, const player_t& p,
 
   fmt::print( os, "\n" );
 
+  if ( p.sim->common_rng )
+  {
+    fmt::print( os, "    Variance Reduction :" );
+    for ( stat_e i = STAT_NONE; i < STAT_MAX; i++ )
+    {
+      if ( p.scaling->scales_with[ i ] )
+      {
+        fmt::print( os, "  {}={:.1f}x",
+            util::stat_type_abbrev( i ),
+            p.scaling->scaling_variance_reduction[ sm ].get_stat( i ) );
+      }
+    }
+    fmt::print( os, "\n" );
+  }
+
   std::string wowhead_std = ri.gear_weights_wowhead_std_link[ sm ];
   simplify_html( wowhead_std );
 
@@ -1198,9 +1249,43 @@ void print_profilesets( std::ostream& out, const profileset::profilesets_t& prof
 
   auto results = profilesets.generate_sorted_profilesets();
 
-  range::for_each( results, [ &out ]( const profileset::profile_set_t* profileset ) {
-    fmt::print( out, "    {:-10.3f} : {:s}\n", profileset->result().median(), profileset->name() );
+  range::for_each( results, [ &out, &sim ]( const profileset::profile_set_t* profileset ) {
+    if ( sim.profileset_race_iterations == 0 )
+    {
+      fmt::print( out, "    {:-10.3f} : {:s}\n", profileset->result().median(), profileset->name() );
+    }
+    else if ( profileset->eliminated() )
+    {
+      fmt::print( out, "    {:-10.3f} : {:s} ({} iterations, eliminated after round {})\n",
+                  profileset->result().median(), profileset->name(), profileset->total_iterations(),
+                  profileset->eliminated_round() + 1 );
+    }
+    else
+    {
+      fmt::print( out, "    {:-10.3f} : {:s} ({} iterations)\n", profileset->result().median(),
+                  profileset->name(), profileset->total_iterations() );
+    }
   } );
+
+  if ( sim.common_rng )
+  {
+    fmt::print( out, "\n  Paired mean difference to baseline (common random numbers):\n" );
+    range::for_each( results, [ &out, &sim ]( const profileset::profile_set_t* profileset ) {
+      const auto& result = profileset->result();
+      if ( !result.paired() )
+      {
+        return;
+      }
+
+      fmt::print( out, "    {:+10.3f} (+/- {:.3f}, {:.1f}x variance reduction) : {:s}\n", result.paired_delta(),
+                  sim.confidence_estimator * result.paired_delta_stddev(), result.variance_reduction(),
+                  profileset->name() );
+    } );
+  }
+
+  fmt::print( out, "\n  Setup+Init = {:.3f}s ({} of {} profilesets reused the validation init)\n",
+              chrono::to_fp_seconds( profilesets.init_elapsed() ), profilesets.n_reused(),
+              profilesets.n_profilesets() );
 }
 
 void print_text_report( std::ostream& os, sim_t* sim, bool detail )
@@ -1297,6 +1382,21 @@ void print_text_report( std::ostream& os, sim_t* sim, bool detail )
 
 namespace report
 {
+void print_text( std::ostream& out, sim_t* sim, bool detail )
+{
+  if ( sim->simulation_length.sum() == 0.0 )
+    return;
+
+  try
+  {
+    print_text_report( out, sim, detail );
+  }
+  catch ( const std::exception& e )
+  {
+    sim->error( "Error generating text report: {}", e.what() );
+  }
+}
+
 void print_text( sim_t* sim, bool detail )
 {
   if ( sim->simulation_length.sum() == 0.0 )
@@ -1318,20 +1418,7 @@ void print_text( sim_t* sim, bool detail )
     }
   }
 
-  try
-  {
-    report_timer_t t( "text report", stdout );
-    if ( ! sim -> profileset_enabled )
-    {
-      t.start();
-    }
-
-    print_text_report( *out, sim, detail );
-  }
-  catch ( const std::exception& e )
-  {
-    sim->error( "Error generating text report: {}", e.what() );
-  }
+  print_text( *out, sim, detail );
 }
 
 }  // END report NAMESPACE
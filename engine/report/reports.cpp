@@ -8,14 +8,63 @@
 #include "dbc/dbc.hpp"
 #include "dbc/sc_spell_info.hpp"
 #include "dbc/spell_query/spell_data_expr.hpp"
+#include "player/pet.hpp"
 #include "player/player.hpp"
 #include "report/report_helper.hpp"
 #include "sim/sim.hpp"
+#include "util/chrono.hpp"
+#include "util/concurrency.hpp"
 #include "util/xml.hpp"
 
+#include <functional>
+#include <iostream>
 #include <ostream>
 #include <sstream>
 
+namespace
+{
+/* A report writer, run by report::print_suite. Writers that evaluate actor state ( composite stats,
+ * the lazily filled stat cache, buff benefit tracking ) change that state while reading it, so they
+ * run one after another. The other writers only read collected data and run concurrently with them.
+ */
+struct report_writer_t
+{
+  std::string title;
+  bool enabled;
+  bool reads_actor_state;
+  std::function<void()> write;
+  chrono::wall_clock::duration elapsed;
+};
+
+// Actors with a section in the text or html report
+std::vector<player_t*> reported_actors( const sim_t& sim )
+{
+  std::vector<player_t*> actors;
+
+  auto add_actors = [ &sim, &actors ]( const std::vector<player_t*>& list, bool summoned_pets_only ) {
+    for ( auto* actor : list )
+    {
+      actors.push_back( actor );
+
+      if ( sim.report_pets_separately )
+      {
+        range::copy_if( actor->pet_list, std::back_inserter( actors ), [ summoned_pets_only ]( const pet_t* pet ) {
+          return !summoned_pets_only || ( pet->summoned && !pet->quiet );
+        } );
+      }
+    }
+  };
+
+  add_actors( sim.players_by_name, true );
+  if ( sim.report_targets )
+  {
+    add_actors( sim.targets_by_name, false );
+  }
+
+  return actors;
+}
+}  // unnamed namespace
+
 // report::print_profiles ===================================================
 namespace report
 {
@@ -238,9 +287,71 @@ void print_suite( sim_t* sim )
     fmt::print( "\nGenerating reports...\n" );
   }
 
-  report::print_text(sim, sim->report_details != 0);
-  report::print_json(*sim);
-  report::print_html(*sim);
+  auto start_time = chrono::wall_clock::now();
+
+  // The processed report information of players is read by all writers, generate it before they
+  // start. The JSON report only reads the buff lists, and does not generate them.
+  thread::parallel_for_each( reported_actors( *sim ), sim->threads, []( player_t* p ) {
+    report_helper::generate_player_buff_lists( *p, p->report_information );
+    report_helper::generate_player_charts( *p, p->report_information );
+  } );
+
+  // A text report written to stdout is buffered, so it is not interleaved with the output of the
+  // other writers
+  std::ostringstream text_buffer;
+  bool buffer_text = sim->threads > 1 && sim->output_file_str.empty();
+
+  std::vector<report_writer_t> writers;
+  writers.push_back( { "text report", sim->simulation_length.sum() != 0.0, true, [ sim, buffer_text, &text_buffer ] {
+    if ( buffer_text )
+      report::print_text( text_buffer, sim, sim->report_details != 0 );
+    else
+      report::print_text( sim, sim->report_details != 0 );
+  }, {} } );
+  writers.push_back( { "JSON report", !sim->json_reports.empty(), true, [ sim ] { report::print_json( *sim ); }, {} } );
+  writers.push_back( { "html report", !sim->html_file_str.empty(), true, [ sim ] { report::print_html( *sim ); }, {} } );
+  writers.push_back( { "binary results", !sim->results_binary_file_str.empty(), false,
+                       [ sim ] { report::print_results_binary( *sim ); }, {} } );
+
+  // Writers reading actor state form a single group run in order, every other writer is a group
+  std::vector<report_writer_t*> enabled_writers;
+  std::vector<std::vector<report_writer_t*>> writer_groups( 1 );
+  for ( auto& writer : writers )
+  {
+    if ( !writer.enabled )
+      continue;
+
+    enabled_writers.push_back( &writer );
+    if ( writer.reads_actor_state )
+      writer_groups.front().push_back( &writer );
+    else
+      writer_groups.push_back( { &writer } );
+  }
+
+  thread::parallel_for_each( writer_groups, sim->threads, []( const std::vector<report_writer_t*>& group ) {
+    for ( auto* writer : group )
+    {
+      auto writer_start = chrono::wall_clock::now();
+      writer->write();
+      writer->elapsed = chrono::elapsed( writer_start );
+    }
+  } );
+
+  if ( buffer_text )
+  {
+    std::cout << text_buffer.str();
+    std::cout.flush();
+  }
+
   report::print_profiles(sim);
+
+  if ( !sim->profileset_enabled )
+  {
+    for ( const auto* writer : enabled_writers )
+    {
+      fmt::print( "{} took {}seconds.\n", writer->title, chrono::to_fp_seconds( writer->elapsed ) );
+    }
+    fmt::print( "Reports took {}seconds.\n", chrono::elapsed_fp_seconds( start_time ) );
+  }
 }
 }  // namespace report
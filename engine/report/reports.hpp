@@ -28,8 +28,10 @@ void print_spell_query( std::ostream& out, const sim_t& sim, const spell_data_ex
 void print_spell_query( xml_node_t* out, FILE* file, const sim_t& sim, const spell_data_expr_t&, unsigned level );
 void print_profiles( sim_t* );
 void print_text( sim_t*, bool detail );
+void print_text( std::ostream&, sim_t*, bool detail );
 void print_html( sim_t& );
 void print_json( sim_t& );
+void print_results_binary( sim_t& );
 void print_html_player( report::sc_html_stream&, player_t& );
 void print_suite( sim_t* );
 }  // namespace report
\ No newline at end of file
@@ -339,6 +339,13 @@ int sim_t::main( const std::vector<std::string>& args )
         std::throw_with_nested( std::runtime_error( "Generating profiles" ) );
       }
     }
+    else if ( !merge_snapshot_files.empty() )
+    {
+      fmt::print( "\nMerging {} snapshots...\n\n", merge_snapshot_files.size() );
+
+      merge_snapshots();
+      report::print_suite( this );
+    }
     else
     {
       fmt::print(
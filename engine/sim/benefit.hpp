@@ -56,6 +56,12 @@ public:
     ratio.merge( other.ratio );
   }
 
+  template <typename Archive>
+  void serialize( Archive& ar )
+  {
+    ar( ratio );
+  }
+
   const std::string& name() const
   {
     return name_str;
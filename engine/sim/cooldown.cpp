@@ -12,6 +12,55 @@
 
 namespace { // UNNAMED NAMESPACE
 
+// Cooldown state expression, the result only changes with the ready time and charges of the
+// cooldown, or once the simulation reaches the ready time. Remains expressions count down to the
+// ready time.
+template <typename Fn>
+struct cooldown_state_expr_t : public expr_t
+{
+  const cooldown_t& cooldown;
+  Fn fn;
+  bool remains;
+
+  template <typename T = Fn>
+  cooldown_state_expr_t( util::string_view name, const cooldown_t& cd, T&& fn, bool remains = false )
+    : expr_t( name ), cooldown( cd ), fn( std::forward<T>( fn ) ), remains( remains )
+  { }
+
+  double evaluate() override
+  { return coerce( fn() ); }
+
+  bool dependencies( expression::dependencies_t& deps ) override
+  {
+    deps.watch( cooldown.ready );
+    deps.watch( cooldown.current_charge );
+    deps.watch( cooldown.charges );
+    deps.timed( this );
+    return true;
+  }
+
+  timespan_t next_change( timespan_t now ) override
+  {
+    if ( remains )
+      return now;
+
+    return cooldown.ready >= now ? cooldown.ready : timespan_t::max();
+  }
+
+  bool countdown( timespan_t& end ) override
+  {
+    end = cooldown.ready;
+    return remains;
+  }
+};
+
+template <typename Fn>
+std::unique_ptr<expr_t> make_cooldown_state_expr( util::string_view name, const cooldown_t& cd, Fn&& fn,
+                                                  bool remains = false )
+{
+  return std::make_unique<cooldown_state_expr_t<std::decay_t<Fn>>>( name, cd, std::forward<Fn>( fn ), remains );
+}
+
 struct recharge_event_t : event_t
 {
   cooldown_t* cooldown_;
@@ -516,7 +565,7 @@ timespan_t cooldown_t::cooldown_duration( const cooldown_t* cd )
 std::unique_ptr<expr_t> cooldown_t::create_expression( util::string_view name_str )
 {
   if ( name_str == "remains" )
-    return make_mem_fn_expr( "cooldown_remains", *this, &cooldown_t::remains );
+    return make_cooldown_state_expr( "cooldown_remains", *this, [ this ] { return remains(); }, true );
   else if ( name_str == "base_duration" )
   {
     return make_fn_expr( "cooldown_base_duration", [ this ]
@@ -537,10 +586,10 @@ std::unique_ptr<expr_t> cooldown_t::create_expression( util::string_view name_st
     } );
   }
   else if ( name_str == "up" || name_str == "ready" )
-    return make_mem_fn_expr( "cooldown_up", *this, &cooldown_t::up );
+    return make_cooldown_state_expr( "cooldown_up", *this, [ this ] { return up(); } );
   else if ( name_str == "charges" )
   {
-    return make_fn_expr( name_str, [ this ]
+    return make_cooldown_state_expr( name_str, *this, [ this ]
     {
       if ( charges <= 1 )
       {
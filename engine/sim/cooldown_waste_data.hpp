@@ -23,6 +23,10 @@ struct cooldown_waste_data_t : private noncopyable
   void add( timespan_t cd_override = timespan_t::min(), timespan_t time_to_execute = 0_ms );
   bool active() const;
   void merge( const cooldown_waste_data_t& other );
+
+  template <typename Archive>
+  void serialize( Archive& ar )
+  { ar( normal, cumulative ); }
   void analyze();
   void datacollection_begin();
   void datacollection_end();
@@ -0,0 +1,117 @@
+// ==========================================================================
+// Dedmonwakeen's Raid DPS/TPS Simulator.
+// Send questions to natehieter@gmail.com
+// ==========================================================================
+
+#include "engine_profiler.hpp"
+
+#include "action/action.hpp"
+#include "player/action_priority_list.hpp"
+#include "player/player.hpp"
+#include "sim/event.hpp"
+#include "util/generic.hpp"
+
+engine_profiler_t::entry_t& engine_profiler_t::named_entry( category_e category, util::string_view name )
+{
+  auto& by_name = entry_by_name[ category ];
+  auto it = by_name.find( name );
+  if ( it != by_name.end() )
+  {
+    return *it->second;
+  }
+
+  entries.push_back( { category, std::string( name ), 0, chrono::wall_clock::duration::zero() } );
+  by_name[ entries.back().name ] = &entries.back();
+  return entries.back();
+}
+
+engine_profiler_t::entry_t& engine_profiler_t::event_entry( const event_t& event )
+{
+  // Event types are identified by their name, different event types can share a name string at
+  // different addresses
+  return named_entry( EVENT, event.name() );
+}
+
+engine_profiler_t::entry_t& engine_profiler_t::action_entry( category_e category, const action_t& action )
+{
+  auto& by_key = entry_by_key[ category ];
+  auto it = by_key.find( &action );
+  if ( it != by_key.end() )
+  {
+    return *it->second;
+  }
+
+  std::string name;
+  if ( category == APL_LINE )
+  {
+    name = fmt::format( "{}/{}: {}", action.player->name(),
+                        action.action_list ? action.action_list->name_str : std::string( "none" ),
+                        action.signature_str );
+  }
+  else
+  {
+    name = fmt::format( "{}/{}", action.player->name(), action.name() );
+  }
+
+  auto& entry = named_entry( category, name );
+  by_key[ &action ] = &entry;
+  return entry;
+}
+
+void engine_profiler_t::merge( const engine_profiler_t& other )
+{
+  for ( const auto& other_entry : other.entries )
+  {
+    auto& entry = named_entry( other_entry.category, other_entry.name );
+    entry.count += other_entry.count;
+    entry.time += other_entry.time;
+  }
+}
+
+std::vector<const engine_profiler_t::entry_t*> engine_profiler_t::sorted_entries() const
+{
+  std::vector<const entry_t*> sorted;
+  sorted.reserve( entries.size() );
+  for ( const auto& entry : entries )
+  {
+    if ( entry.count > 0 )
+    {
+      sorted.push_back( &entry );
+    }
+  }
+
+  range::sort( sorted, []( const entry_t* l, const entry_t* r ) {
+    if ( l->time != r->time )
+      return l->time > r->time;
+    return l->name < r->name;
+  } );
+
+  return sorted;
+}
+
+double engine_profiler_t::category_seconds( category_e category ) const
+{
+  chrono::wall_clock::duration total = chrono::wall_clock::duration::zero();
+  for ( const auto& entry : entries )
+  {
+    if ( entry.category == category )
+    {
+      total += entry.time;
+    }
+  }
+
+  return chrono::to_fp_seconds( total );
+}
+
+const char* engine_profiler_t::category_string( category_e category )
+{
+  switch ( category )
+  {
+    case EVENT:          return "event";
+    case ACTION_EXECUTE: return "execute";
+    case ACTION_IMPACT:  return "impact";
+    case ACTION_TICK:    return "tick";
+    case APL_LINE:       return "apl_line";
+    default:             return "unknown";
+  }
+}
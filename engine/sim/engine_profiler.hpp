@@ -0,0 +1,118 @@
+// ==========================================================================
+// Dedmonwakeen's Raid DPS/TPS Simulator.
+// Send questions to natehieter@gmail.com
+// ==========================================================================
+
+#pragma once
+
+#include "config.hpp"
+#include "util/chrono.hpp"
+#include "util/string_view.hpp"
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct action_t;
+struct event_t;
+
+// Engine Profiler ==========================================================
+
+/* Wall clock time and call counts of the simulation engine ( profile_engine=1 ), aggregated per
+ * event type ( event_t::name() ), per action execute, impact and tick, and per APL line readiness
+ * check. Each thread profiles its own simulation, profiles are merged by name with the simulation
+ * results. Times are inclusive: an action executed by an event is also part of the event time.
+ *
+ * The profiled code opens scopes with ENGINE_PROFILER_SCOPE(), which compiles to nothing unless
+ * ENGINE_PROFILER is defined ( see config.hpp ).
+ */
+struct engine_profiler_t
+{
+  enum category_e
+  {
+    EVENT = 0,
+    ACTION_EXECUTE,
+    ACTION_IMPACT,
+    ACTION_TICK,
+    APL_LINE,
+    CATEGORY_MAX
+  };
+
+  struct entry_t
+  {
+    category_e category;
+    std::string name;
+    uint64_t count;
+    chrono::wall_clock::duration time;
+
+    double seconds() const
+    { return chrono::to_fp_seconds( time ); }
+  };
+
+  /* Times the lifetime of the scope into a profile entry. Scopes of a disabled profiler ( nullptr )
+   * do nothing.
+   */
+  class scope_t
+  {
+    entry_t* entry;
+    chrono::wall_clock::time_point start;
+
+  public:
+    scope_t( engine_profiler_t* profiler, const event_t& event )
+      : entry( profiler ? &profiler->event_entry( event ) : nullptr ), start()
+    {
+      if ( entry )
+        start = chrono::wall_clock::now();
+    }
+
+    scope_t( engine_profiler_t* profiler, category_e category, const action_t& action )
+      : entry( profiler ? &profiler->action_entry( category, action ) : nullptr ), start()
+    {
+      if ( entry )
+        start = chrono::wall_clock::now();
+    }
+
+    ~scope_t()
+    {
+      if ( entry )
+      {
+        entry->count++;
+        entry->time += chrono::wall_clock::now() - start;
+      }
+    }
+
+    scope_t( const scope_t& ) = delete;
+    scope_t& operator=( const scope_t& ) = delete;
+  };
+
+  entry_t& event_entry( const event_t& event );
+  entry_t& action_entry( category_e category, const action_t& action );
+
+  void merge( const engine_profiler_t& other );
+
+  /// Profile entries sorted by descending total time
+  std::vector<const entry_t*> sorted_entries() const;
+  /// Total time of all entries in a category
+  double category_seconds( category_e category ) const;
+
+  static const char* category_string( category_e category );
+
+private:
+  // Entries are referenced by active scopes, and must not move when new entries are added
+  std::deque<entry_t> entries;
+  // Action entries by action
+  std::array<std::unordered_map<const void*, entry_t*>, CATEGORY_MAX> entry_by_key;
+  // Entries by name, the keys view the names owned by the entries
+  std::array<std::unordered_map<util::string_view, entry_t*>, CATEGORY_MAX> entry_by_name;
+
+  entry_t& named_entry( category_e category, util::string_view name );
+};
+
+#ifdef ENGINE_PROFILER
+#define ENGINE_PROFILER_SCOPE( ... ) engine_profiler_t::scope_t engine_profiler_scope( __VA_ARGS__ )
+#else
+#define ENGINE_PROFILER_SCOPE( ... ) ( void ) 0
+#endif
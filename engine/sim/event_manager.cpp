@@ -5,10 +5,25 @@
 
 #include "event_manager.hpp"
 #include "event.hpp"
+#include "engine_profiler.hpp"
 #include "util/util.hpp"
 #include "sim/sim.hpp"
 #include "player/player.hpp"
 
+#include <algorithm>
+
+namespace
+{
+// Heap comparator, true if a is executed after b. Events are ordered by time, ties are broken by
+// scheduling order (event id), which is the order the timing wheel produces.
+bool event_after( const event_t* a, const event_t* b )
+{
+  if ( a->time != b->time )
+    return a->time > b->time;
+
+  return a->id > b->id;
+}
+}  // namespace
 
 event_manager_t::event_manager_t( sim_t* s )
   : sim( s ),
@@ -20,13 +35,21 @@ event_manager_t::event_manager_t( sim_t* s )
     global_event_id( 1 ),  // start at 1, so we can identify event -> id == 0
                            // meaning a unscheduled event.
     timing_wheel(),
-    recycled_event_list( nullptr ),
+    event_allocator(),
     wheel_seconds( 0 ),
     wheel_size( 0 ),
     wheel_mask( 0 ),
     wheel_shift( 5 ),
     wheel_granularity( 0.0 ),
     wheel_time( timespan_t::zero() ),
+    queue_type( EVENT_QUEUE_WHEEL ),
+    fine_wheel(),
+    coarse_wheel(),
+    event_heap(),
+    current_slice( 0 ),
+    fine_bits( 5 ),
+    fine_mask( 0 ),
+    coarse_mask( 0 ),
     event_stopwatch(),
 #ifdef EVENT_QUEUE_DEBUG
     monitor_cpu( false ),
@@ -35,7 +58,9 @@ event_manager_t::event_manager_t( sim_t* s )
     n_requested_events( 0 ),
     n_end_insert( 0 ),
     events_traversed( 0 ),
-    events_added( 0 )
+    events_added( 0 ),
+    insert_time(),
+    pop_time()
 #else
     monitor_cpu( false ),
     canceled( false )
@@ -46,25 +71,17 @@ event_manager_t::event_manager_t( sim_t* s )
 
 // event_manager_t::~event_manager_t ========================================
 
-event_manager_t::~event_manager_t()
-{
-  while ( recycled_event_list )
-  {
-    event_t* e          = recycled_event_list;
-    recycled_event_list = e->next;
-    free( e );
-  }
-}
+event_manager_t::~event_manager_t() = default;
 
 // event_manager_t::allocate_event ==========================================
 
 void* event_manager_t::allocate_event( const std::size_t size )
 {
-  static constexpr std::size_t SIZE = util::next_power_of_two( 2 * sizeof( event_t ) );
-  assert( SIZE > size );
-  (void)size;
+  if ( size > event_allocator.max_size )
+  {
+    throw std::bad_alloc();
+  }
 
-  event_t* e = recycled_event_list;
 #ifdef EVENT_QUEUE_DEBUG
   n_requested_events++;
   if ( size >= event_requested_size_count.size() )
@@ -73,25 +90,17 @@ void* event_manager_t::allocate_event( const std::size_t size )
   }
   event_requested_size_count[ size ]++;
 #endif
-  if ( e )
-  {
-    recycled_event_list = e->next;
-  }
-  else
-  {
-    e = (event_t*)malloc( SIZE );
 
-    if ( !e )
-    {
-      throw std::bad_alloc();
-    }
-    else
-    {
+  // Events are recycled into the free list of their size class, only freshly carved blocks need to
+  // be tracked for flushing.
+  bool recycled = event_allocator.has_free_block( size );
+  void* e = event_allocator.allocate( size );
+  if ( !recycled )
+  {
 #ifdef EVENT_QUEUE_DEBUG
-      n_allocated_events++;
+    n_allocated_events++;
 #endif
-      allocated_events.push_back( e );
-    }
+    allocated_events.push_back( static_cast<event_t*>( e ) );
   }
 
   return e;
@@ -102,9 +111,10 @@ void* event_manager_t::allocate_event( const std::size_t size )
 void event_manager_t::recycle_event( event_t* e )
 {
   e->~event_t();
-  e->recycled         = true;
-  e->next             = recycled_event_list;
-  recycled_event_list = e;
+  // The free list link overwrites the (dead) vtable pointer, the recycled flag stays intact for
+  // flush()
+  e->recycled = true;
+  event_allocator.deallocate( e );
 }
 
 // event_manager_t::add_event ===============================================
@@ -128,6 +138,48 @@ void event_manager_t::add_event( event_t* e, timespan_t delta_time )
     e->reschedule_time = timespan_t::zero();
   }
 
+#ifdef EVENT_QUEUE_DEBUG
+  auto insert_start = chrono::wall_clock::now();
+#endif
+
+  switch ( queue_type )
+  {
+    case EVENT_QUEUE_HIERARCHICAL:
+      hierarchical_insert( e );
+      break;
+    case EVENT_QUEUE_HEAP:
+      heap_insert( e );
+      break;
+    default:
+      wheel_insert( e );
+      break;
+  }
+
+#ifdef EVENT_QUEUE_DEBUG
+  events_added++;
+  insert_time += chrono::wall_clock::now() - insert_start;
+#endif
+
+  if ( ++events_remaining > max_events_remaining )
+    max_events_remaining = events_remaining;
+
+  if ( sim->debug )
+    sim->print_debug( "Add Event: {} time={} reschedule={}", *e, e->time, e->reschedule_time );
+
+#ifdef ACTOR_EVENT_BOOKKEEPING
+  if ( sim->debug && e->actor )
+  {
+    e->actor->event_counter++;
+    sim->print_debug( "Actor {} has {} scheduled events", e->actor->name(),
+                           e->actor->event_counter );
+  }
+#endif
+}
+
+// event_manager_t::wheel_insert ============================================
+
+void event_manager_t::wheel_insert( event_t* e )
+{
   // Determine the timing wheel position to which the event will belong
   // Only valid for integer based timespan_t
   uint32_t slice = static_cast<uint32_t>(
@@ -148,7 +200,6 @@ void event_manager_t::add_event( event_t* e, timespan_t delta_time )
 #endif
   }
 #ifdef EVENT_QUEUE_DEBUG
-  events_added++;
   events_traversed += traversed;
   if ( traversed > max_queue_depth )
   {
@@ -171,21 +222,43 @@ void event_manager_t::add_event( event_t* e, timespan_t delta_time )
   // insert event
   e->next = *prev;
   *prev   = e;
+}
 
-  if ( ++events_remaining > max_events_remaining )
-    max_events_remaining = events_remaining;
+// event_manager_t::hierarchical_insert =====================================
 
-  if ( sim->debug )
-    sim->print_debug( "Add Event: {} time={} reschedule={}", *e, e->time, e->reschedule_time );
+void event_manager_t::hierarchical_insert( event_t* e )
+{
+  // Only valid for integer based timespan_t
+  uint64_t slice = static_cast<uint64_t>( e->time.total_millis() ) >> wheel_shift;
+  assert( slice >= current_slice && "Event scheduled before the current time slice" );
 
-#ifdef ACTOR_EVENT_BOOKKEEPING
-  if ( sim->debug && e->actor )
+  // Events in the slice being drained go straight to the heap, events in the remainder of the
+  // current coarse slot to an unsorted fine slot list, and everything else to an unsorted coarse
+  // slot list. Lists are only ordered once the wheel reaches them.
+  if ( slice <= current_slice )
   {
-    e->actor->event_counter++;
-    sim->print_debug( "Actor {} has {} scheduled events", e->actor->name(),
-                           e->actor->event_counter );
+    heap_insert( e );
+  }
+  else if ( ( slice >> fine_bits ) == ( current_slice >> fine_bits ) )
+  {
+    event_t*& list = fine_wheel[ slice & fine_mask ];
+    e->next = list;
+    list = e;
+  }
+  else
+  {
+    event_t*& list = coarse_wheel[ ( slice >> fine_bits ) & coarse_mask ];
+    e->next = list;
+    list = e;
   }
-#endif
+}
+
+// event_manager_t::heap_insert =============================================
+
+void event_manager_t::heap_insert( event_t* e )
+{
+  event_heap.push_back( e );
+  std::push_heap( event_heap.begin(), event_heap.end(), event_after );
 }
 
 // event_manager_t::reschedule_event ========================================
@@ -256,6 +329,8 @@ bool event_manager_t::execute()
     {
       sim->print_debug( "Executing event: {}", *e );
 
+      ENGINE_PROFILER_SCOPE( sim->engine_profiler.get(), *e );
+
       if ( monitor_cpu )
       {
 #ifdef ACTOR_EVENT_BOOKKEEPING
@@ -313,6 +388,9 @@ void event_manager_t::flush()
 
   // Clear Timing Wheel
   timing_wheel.assign( timing_wheel.size(), nullptr );
+  fine_wheel.assign( fine_wheel.size(), nullptr );
+  coarse_wheel.assign( coarse_wheel.size(), nullptr );
+  event_heap.clear();
 }
 
 // event_manager_t::init ====================================================
@@ -343,7 +421,24 @@ void event_manager_t::init()
 
   // The timing wheel represents an array of event lists: Each time slice has an
   // event list.
-  timing_wheel.resize( wheel_size );
+  switch ( queue_type )
+  {
+    case EVENT_QUEUE_HIERARCHICAL:
+      // Fine slots cover one coarse slot, coarse slots cover the whole wheel. The wheel_shift option
+      // range keeps the wheel at least as large as the fine wheel.
+      assert( wheel_size >= ( 1 << fine_bits ) );
+      fine_mask   = ( 1U << fine_bits ) - 1;
+      coarse_mask = ( static_cast<unsigned>( wheel_size ) >> fine_bits ) - 1;
+      fine_wheel.resize( fine_mask + 1 );
+      coarse_wheel.resize( coarse_mask + 1 );
+      break;
+    case EVENT_QUEUE_HEAP:
+      event_heap.reserve( 256 );
+      break;
+    default:
+      timing_wheel.resize( wheel_size );
+      break;
+  }
 }
 
 // event_manager_t::next_event ==============================================
@@ -353,6 +448,37 @@ event_t* event_manager_t::next_event()
   if ( events_remaining == 0 )
     return nullptr;
 
+#ifdef EVENT_QUEUE_DEBUG
+  auto pop_start = chrono::wall_clock::now();
+#endif
+
+  event_t* e;
+  switch ( queue_type )
+  {
+    case EVENT_QUEUE_HIERARCHICAL:
+      e = hierarchical_next();
+      break;
+    case EVENT_QUEUE_HEAP:
+      e = heap_next();
+      break;
+    default:
+      e = wheel_next();
+      break;
+  }
+
+#ifdef EVENT_QUEUE_DEBUG
+  pop_time += chrono::wall_clock::now() - pop_start;
+#endif
+
+  events_remaining--;
+  events_processed++;
+  return e;
+}
+
+// event_manager_t::wheel_next ==============================================
+
+event_t* event_manager_t::wheel_next()
+{
   while ( true )
   {
     event_t*& event_list = timing_wheel[ timing_slice ];
@@ -360,8 +486,6 @@ event_t* event_manager_t::next_event()
     {
       event_t* e = event_list;
       event_list = e->next;
-      events_remaining--;
-      events_processed++;
       return e;
     }
 
@@ -372,8 +496,55 @@ event_t* event_manager_t::next_event()
       // Time Wheel turns around.
     }
   }
+}
+
+// event_manager_t::hierarchical_next =======================================
+
+event_t* event_manager_t::hierarchical_next()
+{
+  while ( event_heap.empty() )
+  {
+    current_slice++;
+
+    // Entering a new coarse slot, distribute its events into the fine slots
+    if ( ( current_slice & fine_mask ) == 0 )
+    {
+      event_t*& coarse_list = coarse_wheel[ ( current_slice >> fine_bits ) & coarse_mask ];
+      while ( event_t* e = coarse_list )
+      {
+        coarse_list = e->next;
+        uint64_t slice = static_cast<uint64_t>( e->time.total_millis() ) >> wheel_shift;
+        assert( ( slice >> fine_bits ) == ( current_slice >> fine_bits ) );
+        event_t*& fine_list = fine_wheel[ slice & fine_mask ];
+        e->next = fine_list;
+        fine_list = e;
+      }
+    }
 
-  return nullptr;
+    event_t*& fine_list = fine_wheel[ current_slice & fine_mask ];
+    if ( fine_list )
+    {
+      while ( event_t* e = fine_list )
+      {
+        fine_list = e->next;
+        e->next = nullptr;
+        event_heap.push_back( e );
+      }
+      std::make_heap( event_heap.begin(), event_heap.end(), event_after );
+    }
+  }
+
+  return heap_next();
+}
+
+// event_manager_t::heap_next ===============================================
+
+event_t* event_manager_t::heap_next()
+{
+  std::pop_heap( event_heap.begin(), event_heap.end(), event_after );
+  event_t* e = event_heap.back();
+  event_heap.pop_back();
+  return e;
 }
 
 // event_manager_t::reset ===================================================
@@ -383,6 +554,7 @@ void event_manager_t::reset()
   events_remaining = 0;
   events_processed = 0;
   timing_slice     = 0;
+  current_slice    = 0;
   global_event_id  = 0;
   canceled         = false;
   current_time     = timespan_t::zero();
@@ -419,6 +591,8 @@ void event_manager_t::merge( event_manager_t& other )
     event_queue_depth_samples[ i ].second +=
         other.event_queue_depth_samples[ i ].second;
   }
+  insert_time += other.insert_time;
+  pop_time += other.pop_time;
   for ( size_t i = 0; i < other.event_requested_size_count.size(); ++i )
   {
     event_requested_size_count[ i ] += other.event_requested_size_count[ i ];
@@ -470,3 +644,15 @@ void event_manager_t::cancel_stuck( std::vector<std::string>& debug_list )
     sim->cancel_iteration();
   }
 }
+
+// event_manager_t::queue_type_str ==========================================
+
+const char* event_manager_t::queue_type_str() const
+{
+  switch ( queue_type )
+  {
+    case EVENT_QUEUE_HIERARCHICAL: return "hierarchical";
+    case EVENT_QUEUE_HEAP:         return "heap";
+    default:                       return "wheel";
+  }
+}
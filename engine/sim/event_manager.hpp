@@ -7,6 +7,7 @@
 
 #include "config.hpp"
 
+#include "util/allocator.hpp"
 #include "util/chrono.hpp"
 #include "util/stopwatch.hpp"
 #include "util/timespan.hpp"
@@ -17,6 +18,14 @@
 struct event_t;
 struct sim_t;
 
+// Event queue implementations. All of them yield events in the same (time, id) order.
+enum event_queue_e
+{
+  EVENT_QUEUE_WHEEL = 0,    // Single-level timing wheel with sorted per-slice lists
+  EVENT_QUEUE_HIERARCHICAL, // Two-level timing wheel, slices are heap-ordered once reached
+  EVENT_QUEUE_HEAP,         // Binary min-heap over all scheduled events
+};
+
 // Event manager
 struct event_manager_t
 {
@@ -28,11 +37,20 @@ struct event_manager_t
   uint64_t max_events_remaining;
   unsigned timing_slice, global_event_id;
   std::vector<event_t*> timing_wheel;
-  event_t* recycled_event_list;
+  util::slab_allocator_t<> event_allocator;
   int wheel_seconds, wheel_size, wheel_mask, wheel_shift;
   double wheel_granularity;
   timespan_t wheel_time;
   std::vector<event_t*> allocated_events;
+  event_queue_e queue_type;
+
+  // Hierarchical queue: fine_wheel spans one coarse slot, event_heap holds the slice being drained.
+  // The heap queue uses event_heap for all scheduled events.
+  std::vector<event_t*> fine_wheel;
+  std::vector<event_t*> coarse_wheel;
+  std::vector<event_t*> event_heap;
+  uint64_t current_slice;
+  unsigned fine_bits, fine_mask, coarse_mask;
 
   stopwatch_t<chrono::thread_clock> event_stopwatch;
   bool monitor_cpu;
@@ -42,6 +60,7 @@ struct event_manager_t
   uint64_t events_traversed, events_added;
   std::vector<std::pair<unsigned, unsigned> > event_queue_depth_samples;
   std::vector<unsigned> event_requested_size_count;
+  chrono::wall_clock::duration insert_time, pop_time;
 #endif /* EVENT_QUEUE_DEBUG */
 
   event_manager_t( sim_t* );
@@ -58,4 +77,13 @@ struct event_manager_t
   void reset();
   void merge( event_manager_t& other );
   void cancel_stuck( std::vector<std::string>& debug_list );
+  const char* queue_type_str() const;
+
+private:
+  void wheel_insert( event_t* );
+  void hierarchical_insert( event_t* );
+  void heap_insert( event_t* );
+  event_t* wheel_next();
+  event_t* hierarchical_next();
+  event_t* heap_next();
 };
@@ -7,11 +7,99 @@
 #include "action/action.hpp"
 #include "player/player.hpp"
 #include "sim/sim.hpp"
+#include "util/chrono.hpp"
+#include <algorithm>
 #include <atomic>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <type_traits>
 
 namespace expression
 {
 
+// Bytecode =================================================================
+
+/* Compiled expressions ( apl_expression_compiler=1 ) evaluate a flat array of instructions on a
+ * small register file. Each instruction writes register dst from registers a and b, an immediate
+ * value, a variable address, or a call to a leaf expression. Short-circuiting logical operators
+ * jump over their right operand.
+ */
+enum opcode_e : uint8_t
+{
+  OP_CONST = 0,
+  OP_LOAD_DOUBLE,
+  OP_LOAD_INT,
+  OP_LOAD_BOOL,
+  OP_CALL,
+  OP_NEG,
+  OP_NOT,
+  OP_ABS,
+  OP_FLOOR,
+  OP_CEIL,
+  OP_ADD,
+  OP_SUB,
+  OP_MUL,
+  OP_DIV,
+  OP_MOD,
+  OP_MAX,
+  OP_MIN,
+  OP_EQ,
+  OP_NOTEQ,
+  OP_LT,
+  OP_LTEQ,
+  OP_GT,
+  OP_GTEQ,
+  OP_LAND,
+  OP_LOR,
+  OP_XOR,
+  OP_BOOL,
+  OP_JZ,   // if a == 0: dst = 0, jump to target
+  OP_JNZ,  // if a != 0: dst = 1, jump to target
+  OP_RET,
+  OP_INVALID
+};
+
+struct instruction_t
+{
+  opcode_e op;
+  uint16_t dst, a, b;
+  union
+  {
+    double value;
+    const void* address;
+    expr_t* expr;
+    size_t target;
+  };
+};
+
+class compiler_t
+{
+public:
+  std::vector<instruction_t> code;
+  unsigned registers = 0;
+
+  // Emit instructions evaluating e into register reg
+  void compile( expr_t* e, unsigned reg );
+
+  instruction_t& add( opcode_e op, unsigned dst, unsigned a = 0, unsigned b = 0 );
+  void unary( opcode_e op, expr_t* input, unsigned reg );
+  void binary( opcode_e op, expr_t* left, expr_t* right, unsigned reg );
+  void binary( opcode_e op, double left, expr_t* right, unsigned reg );
+  void binary( opcode_e op, expr_t* left, double right, unsigned reg );
+  void short_circuit( opcode_e jump, expr_t* left, expr_t* right, unsigned reg );
+};
+
+namespace
+{
+// Opcode of the functors used by unary and binary expressions, OP_INVALID if there is none
+template <typename F>
+constexpr opcode_e unary_opcode();
+
+template <template <typename> class F>
+constexpr opcode_e binary_opcode();
+}
+
 namespace
 {  // ANONYMOUS ====================================================
 
@@ -160,6 +248,24 @@ public:
   {
     return F()( input->eval() );
   }
+
+  bool emit( compiler_t& compiler, unsigned reg ) override
+  {
+    if constexpr ( unary_opcode<F>() == OP_INVALID )
+    {
+      return false;
+    }
+    else
+    {
+      compiler.unary( unary_opcode<F>(), input.get(), reg );
+      return true;
+    }
+  }
+
+  bool dependencies( dependencies_t& deps ) override
+  {
+    return input->dependencies( deps );
+  }
 };
 
 namespace unary
@@ -217,6 +323,84 @@ namespace binary
   };
 }
 
+template <typename F>
+constexpr opcode_e unary_opcode()
+{
+  if constexpr ( std::is_same_v<F, std::negate<>> )            return OP_NEG;
+  else if constexpr ( std::is_same_v<F, std::logical_not<>> )  return OP_NOT;
+  else if constexpr ( std::is_same_v<F, unary::abs> )          return OP_ABS;
+  else if constexpr ( std::is_same_v<F, unary::floor> )        return OP_FLOOR;
+  else if constexpr ( std::is_same_v<F, unary::ceil> )         return OP_CEIL;
+  else                                                         return OP_INVALID;
+}
+
+template <template <typename> class F>
+constexpr opcode_e binary_opcode()
+{
+  using f = F<double>;
+  if constexpr ( std::is_same_v<f, std::plus<double>> )                 return OP_ADD;
+  else if constexpr ( std::is_same_v<f, std::minus<double>> )           return OP_SUB;
+  else if constexpr ( std::is_same_v<f, std::multiplies<double>> )      return OP_MUL;
+  else if constexpr ( std::is_same_v<f, std::divides<double>> )         return OP_DIV;
+  else if constexpr ( std::is_same_v<f, binary::modulus<double>> )      return OP_MOD;
+  else if constexpr ( std::is_same_v<f, binary::max<double>> )          return OP_MAX;
+  else if constexpr ( std::is_same_v<f, binary::min<double>> )          return OP_MIN;
+  else if constexpr ( std::is_same_v<f, std::equal_to<double>> )        return OP_EQ;
+  else if constexpr ( std::is_same_v<f, std::not_equal_to<double>> )    return OP_NOTEQ;
+  else if constexpr ( std::is_same_v<f, std::less<double>> )            return OP_LT;
+  else if constexpr ( std::is_same_v<f, std::less_equal<double>> )      return OP_LTEQ;
+  else if constexpr ( std::is_same_v<f, std::greater<double>> )         return OP_GT;
+  else if constexpr ( std::is_same_v<f, std::greater_equal<double>> )   return OP_GTEQ;
+  else if constexpr ( std::is_same_v<f, std::logical_and<double>> )     return OP_LAND;
+  else if constexpr ( std::is_same_v<f, std::logical_or<double>> )      return OP_LOR;
+  else                                                                  return OP_INVALID;
+}
+
+template <template <typename> class F>
+constexpr bool is_comparison()
+{
+  return binary_opcode<F>() >= OP_EQ && binary_opcode<F>() <= OP_GTEQ;
+}
+
+// Dependencies of a binary expression with a constant operand. A comparison against a countdown
+// only changes when the countdown crosses the constant, or reaches zero ( see countdown_change() ).
+bool reduced_dependencies( expr_t* self, expr_t* operand, bool comparison, dependencies_t& deps )
+{
+  if ( !operand->dependencies( deps ) )
+  {
+    return false;
+  }
+
+  timespan_t end;
+  if ( comparison && operand->countdown( end ) )
+  {
+    deps.timed( self, operand );
+  }
+
+  return true;
+}
+
+timespan_t countdown_change( expr_t* operand, double constant, timespan_t now )
+{
+  timespan_t end;
+  if ( !operand->countdown( end ) )
+  {
+    return now;
+  }
+
+  timespan_t next = end >= now ? end : timespan_t::max();
+  if ( constant > 0 && constant < 1.0e6 )
+  {
+    timespan_t crossing = end - timespan_t::from_seconds( constant );
+    if ( crossing >= now )
+    {
+      next = std::min( next, crossing );
+    }
+  }
+
+  return next;
+}
+
 std::unique_ptr<expr_t> select_unary( util::string_view name, token_e op, std::unique_ptr<expr_t> input )
 {
   switch ( op )
@@ -268,6 +452,17 @@ public:
   {
     return left->eval() && right->eval();
   }
+
+  bool emit( compiler_t& compiler, unsigned reg ) override
+  {
+    compiler.short_circuit( OP_JZ, left.get(), right.get(), reg );
+    return true;
+  }
+
+  bool dependencies( dependencies_t& deps ) override
+  {
+    return left->dependencies( deps ) && right->dependencies( deps );
+  }
 };
 
 class logical_or_t : public binary_base_t
@@ -282,6 +477,17 @@ public:
   {
     return left->eval() || right->eval();
   }
+
+  bool emit( compiler_t& compiler, unsigned reg ) override
+  {
+    compiler.short_circuit( OP_JNZ, left.get(), right.get(), reg );
+    return true;
+  }
+
+  bool dependencies( dependencies_t& deps ) override
+  {
+    return left->dependencies( deps ) && right->dependencies( deps );
+  }
 };
 
 class logical_xor_t : public binary_base_t
@@ -296,6 +502,17 @@ public:
   {
     return bool( left->eval() != 0 ) != bool( right->eval() != 0 );
   }
+
+  bool emit( compiler_t& compiler, unsigned reg ) override
+  {
+    compiler.binary( OP_XOR, left.get(), right.get(), reg );
+    return true;
+  }
+
+  bool dependencies( dependencies_t& deps ) override
+  {
+    return left->dependencies( deps ) && right->dependencies( deps );
+  }
 };
 
 template <template <typename> class F, typename T = double>
@@ -311,6 +528,24 @@ public:
   {
     return static_cast<double>( F<T>()( static_cast<T>( left->eval() ), static_cast<T>( right->eval() ) ) );
   }
+
+  bool emit( compiler_t& compiler, unsigned reg ) override
+  {
+    if constexpr ( binary_opcode<F>() == OP_INVALID || !std::is_same_v<T, double> )
+    {
+      return false;
+    }
+    else
+    {
+      compiler.binary( binary_opcode<F>(), left.get(), right.get(), reg );
+      return true;
+    }
+  }
+
+  bool dependencies( dependencies_t& deps ) override
+  {
+    return left->dependencies( deps ) && right->dependencies( deps );
+  }
 };
 
 std::unique_ptr<expr_t> select_binary( util::string_view name, token_e op, std::unique_ptr<expr_t> left,
@@ -523,6 +758,29 @@ struct left_reduced_t : public expr_t
   {
     return static_cast<double>( F<T>()( static_cast<T>( left ), static_cast<T>( right->eval() ) ) );
   }
+
+  bool emit( compiler_t& compiler, unsigned reg ) override
+  {
+    if constexpr ( binary_opcode<F>() == OP_INVALID || !std::is_same_v<T, double> )
+    {
+      return false;
+    }
+    else
+    {
+      compiler.binary( binary_opcode<F>(), left, right.get(), reg );
+      return true;
+    }
+  }
+
+  bool dependencies( dependencies_t& deps ) override
+  {
+    return reduced_dependencies( this, right.get(), is_comparison<F>(), deps );
+  }
+
+  timespan_t next_change( timespan_t now ) override
+  {
+    return countdown_change( right.get(), left, now );
+  }
 };
 
 template <template <typename> class F, typename T = double>
@@ -555,6 +813,29 @@ struct right_reduced_t : public expr_t
   {
     return static_cast<double>( F<T>()( static_cast<T>( left->eval() ), static_cast<T>( right ) ) );
   }
+
+  bool emit( compiler_t& compiler, unsigned reg ) override
+  {
+    if constexpr ( binary_opcode<F>() == OP_INVALID || !std::is_same_v<T, double> )
+    {
+      return false;
+    }
+    else
+    {
+      compiler.binary( binary_opcode<F>(), left.get(), right, reg );
+      return true;
+    }
+  }
+
+  bool dependencies( dependencies_t& deps ) override
+  {
+    return reduced_dependencies( this, left.get(), is_comparison<F>(), deps );
+  }
+
+  timespan_t next_change( timespan_t now ) override
+  {
+    return countdown_change( left.get(), right, now );
+  }
 };
 class analyze_logical_and_t : public analyze_binary_base_t
 {
@@ -1032,6 +1313,365 @@ int precedence( token_e expr_token_type )
 
 }  // UNNAMED NAMESPACE ====================================================
 
+// Bytecode compiler ========================================================
+
+instruction_t& compiler_t::add( opcode_e op, unsigned dst, unsigned a, unsigned b )
+{
+  assert( dst <= std::numeric_limits<uint16_t>::max() );
+
+  instruction_t i;
+  i.op     = op;
+  i.dst    = static_cast<uint16_t>( dst );
+  i.a      = static_cast<uint16_t>( a );
+  i.b      = static_cast<uint16_t>( b );
+  i.target = 0;
+
+  code.push_back( i );
+  return code.back();
+}
+
+void compiler_t::compile( expr_t* e, unsigned reg )
+{
+  registers = std::max( registers, reg + 1 );
+
+  if ( e->is_constant() )
+  {
+    add( OP_CONST, reg ).value = e->evaluate();
+  }
+  else if ( !e->emit( *this, reg ) )
+  {
+    add( OP_CALL, reg ).expr = e;
+  }
+}
+
+void compiler_t::unary( opcode_e op, expr_t* input, unsigned reg )
+{
+  compile( input, reg );
+  add( op, reg, reg );
+}
+
+void compiler_t::binary( opcode_e op, expr_t* left, expr_t* right, unsigned reg )
+{
+  compile( left, reg );
+  compile( right, reg + 1 );
+  add( op, reg, reg, reg + 1 );
+}
+
+void compiler_t::binary( opcode_e op, double left, expr_t* right, unsigned reg )
+{
+  add( OP_CONST, reg ).value = left;
+  compile( right, reg + 1 );
+  add( op, reg, reg, reg + 1 );
+}
+
+void compiler_t::binary( opcode_e op, expr_t* left, double right, unsigned reg )
+{
+  compile( left, reg );
+  registers = std::max( registers, reg + 2 );
+  add( OP_CONST, reg + 1 ).value = right;
+  add( op, reg, reg, reg + 1 );
+}
+
+// Logical and/or: the jump produces the result when the left operand decides it, otherwise the
+// result is the truth value of the right operand
+void compiler_t::short_circuit( opcode_e jump, expr_t* left, expr_t* right, unsigned reg )
+{
+  compile( left, reg );
+  size_t jump_index = code.size();
+  add( jump, reg, reg );
+  compile( right, reg );
+  add( OP_BOOL, reg, reg );
+  code[ jump_index ].target = code.size();
+}
+
+void emit_load( compiler_t& compiler, unsigned reg, const double* v )
+{
+  compiler.registers = std::max( compiler.registers, reg + 1 );
+  compiler.add( OP_LOAD_DOUBLE, reg ).address = v;
+}
+
+void emit_load( compiler_t& compiler, unsigned reg, const int* v )
+{
+  compiler.registers = std::max( compiler.registers, reg + 1 );
+  compiler.add( OP_LOAD_INT, reg ).address = v;
+}
+
+void emit_load( compiler_t& compiler, unsigned reg, const bool* v )
+{
+  compiler.registers = std::max( compiler.registers, reg + 1 );
+  compiler.add( OP_LOAD_BOOL, reg ).address = v;
+}
+
+// Bytecode interpreter =====================================================
+
+// GCC and Clang dispatch every instruction directly to its handler through a computed goto, other
+// compilers use a switch
+#if defined( __GNUC__ ) || defined( __clang__ )
+#define SC_EXPR_THREADED_DISPATCH 1
+#else
+#define SC_EXPR_THREADED_DISPATCH 0
+#endif
+
+#if SC_EXPR_THREADED_DISPATCH
+// Label addresses and computed gotos are extensions
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+#endif
+
+namespace
+{
+double run( const instruction_t* code, double* r )
+{
+  const instruction_t* ip = code;
+
+#if SC_EXPR_THREADED_DISPATCH
+#define VM_LABEL( name ) &&l_##name
+  static const void* const dispatch[] = {
+    VM_LABEL( OP_CONST ), VM_LABEL( OP_LOAD_DOUBLE ), VM_LABEL( OP_LOAD_INT ), VM_LABEL( OP_LOAD_BOOL ),
+    VM_LABEL( OP_CALL ), VM_LABEL( OP_NEG ), VM_LABEL( OP_NOT ), VM_LABEL( OP_ABS ), VM_LABEL( OP_FLOOR ),
+    VM_LABEL( OP_CEIL ), VM_LABEL( OP_ADD ), VM_LABEL( OP_SUB ), VM_LABEL( OP_MUL ), VM_LABEL( OP_DIV ),
+    VM_LABEL( OP_MOD ), VM_LABEL( OP_MAX ), VM_LABEL( OP_MIN ), VM_LABEL( OP_EQ ), VM_LABEL( OP_NOTEQ ),
+    VM_LABEL( OP_LT ), VM_LABEL( OP_LTEQ ), VM_LABEL( OP_GT ), VM_LABEL( OP_GTEQ ), VM_LABEL( OP_LAND ),
+    VM_LABEL( OP_LOR ), VM_LABEL( OP_XOR ), VM_LABEL( OP_BOOL ), VM_LABEL( OP_JZ ), VM_LABEL( OP_JNZ ),
+    VM_LABEL( OP_RET )
+  };
+#undef VM_LABEL
+  static_assert( sizeof( dispatch ) / sizeof( dispatch[ 0 ] ) == OP_INVALID, "Dispatch table does not match opcodes" );
+#define VM_DISPATCH() goto* dispatch[ ip->op ]
+#define VM_OP( name ) l_##name:
+#else
+#define VM_DISPATCH() goto dispatch_switch
+#define VM_OP( name ) case name:
+#endif
+#define VM_NEXT() ++ip; VM_DISPATCH()
+
+  VM_DISPATCH();
+
+#if !SC_EXPR_THREADED_DISPATCH
+dispatch_switch:
+  switch ( ip->op )
+#endif
+  {
+    VM_OP( OP_CONST )       r[ ip->dst ] = ip->value; VM_NEXT();
+    VM_OP( OP_LOAD_DOUBLE ) r[ ip->dst ] = *static_cast<const double*>( ip->address ); VM_NEXT();
+    VM_OP( OP_LOAD_INT )    r[ ip->dst ] = static_cast<double>( *static_cast<const int*>( ip->address ) ); VM_NEXT();
+    VM_OP( OP_LOAD_BOOL )   r[ ip->dst ] = static_cast<double>( *static_cast<const bool*>( ip->address ) ); VM_NEXT();
+    VM_OP( OP_CALL )        r[ ip->dst ] = ip->expr->eval(); VM_NEXT();
+    VM_OP( OP_NEG )         r[ ip->dst ] = -r[ ip->a ]; VM_NEXT();
+    VM_OP( OP_NOT )         r[ ip->dst ] = !r[ ip->a ]; VM_NEXT();
+    VM_OP( OP_ABS )         r[ ip->dst ] = std::fabs( r[ ip->a ] ); VM_NEXT();
+    VM_OP( OP_FLOOR )       r[ ip->dst ] = std::floor( r[ ip->a ] ); VM_NEXT();
+    VM_OP( OP_CEIL )        r[ ip->dst ] = std::ceil( r[ ip->a ] ); VM_NEXT();
+    VM_OP( OP_ADD )         r[ ip->dst ] = r[ ip->a ] + r[ ip->b ]; VM_NEXT();
+    VM_OP( OP_SUB )         r[ ip->dst ] = r[ ip->a ] - r[ ip->b ]; VM_NEXT();
+    VM_OP( OP_MUL )         r[ ip->dst ] = r[ ip->a ] * r[ ip->b ]; VM_NEXT();
+    VM_OP( OP_DIV )         r[ ip->dst ] = r[ ip->a ] / r[ ip->b ]; VM_NEXT();
+    VM_OP( OP_MOD )         r[ ip->dst ] = std::fmod( r[ ip->a ], r[ ip->b ] ); VM_NEXT();
+    VM_OP( OP_MAX )         r[ ip->dst ] = std::max( r[ ip->a ], r[ ip->b ] ); VM_NEXT();
+    VM_OP( OP_MIN )         r[ ip->dst ] = std::min( r[ ip->a ], r[ ip->b ] ); VM_NEXT();
+    VM_OP( OP_EQ )          r[ ip->dst ] = r[ ip->a ] == r[ ip->b ]; VM_NEXT();
+    VM_OP( OP_NOTEQ )       r[ ip->dst ] = r[ ip->a ] != r[ ip->b ]; VM_NEXT();
+    VM_OP( OP_LT )          r[ ip->dst ] = r[ ip->a ] < r[ ip->b ]; VM_NEXT();
+    VM_OP( OP_LTEQ )        r[ ip->dst ] = r[ ip->a ] <= r[ ip->b ]; VM_NEXT();
+    VM_OP( OP_GT )          r[ ip->dst ] = r[ ip->a ] > r[ ip->b ]; VM_NEXT();
+    VM_OP( OP_GTEQ )        r[ ip->dst ] = r[ ip->a ] >= r[ ip->b ]; VM_NEXT();
+    VM_OP( OP_LAND )        r[ ip->dst ] = r[ ip->a ] && r[ ip->b ]; VM_NEXT();
+    VM_OP( OP_LOR )         r[ ip->dst ] = r[ ip->a ] || r[ ip->b ]; VM_NEXT();
+    VM_OP( OP_XOR )         r[ ip->dst ] = bool( r[ ip->a ] != 0 ) != bool( r[ ip->b ] != 0 ); VM_NEXT();
+    VM_OP( OP_BOOL )        r[ ip->dst ] = r[ ip->a ] != 0; VM_NEXT();
+    VM_OP( OP_JZ )
+      if ( r[ ip->a ] == 0 )
+      {
+        r[ ip->dst ] = 0;
+        ip = code + ip->target;
+        VM_DISPATCH();
+      }
+      VM_NEXT();
+    VM_OP( OP_JNZ )
+      if ( r[ ip->a ] != 0 )
+      {
+        r[ ip->dst ] = 1;
+        ip = code + ip->target;
+        VM_DISPATCH();
+      }
+      VM_NEXT();
+    VM_OP( OP_RET )         return r[ ip->a ];
+#if !SC_EXPR_THREADED_DISPATCH
+    default:
+      break;
+#endif
+  }
+
+#undef VM_NEXT
+#undef VM_OP
+#undef VM_DISPATCH
+
+  assert( false && "Invalid expression bytecode" );
+  return 0;
+}
+
+#if SC_EXPR_THREADED_DISPATCH
+#pragma GCC diagnostic pop
+#endif
+
+class compiled_expr_t : public expr_t
+{
+  // Keeps the leaf expressions called by the bytecode alive
+  std::unique_ptr<expr_t> source;
+  std::vector<instruction_t> code;
+  std::vector<double> registers;
+
+public:
+  compiled_expr_t( std::unique_ptr<expr_t> e, compiler_t&& compiler )
+    : expr_t( e->name(), e->op_ ), source( std::move( e ) ), code( std::move( compiler.code ) ),
+      registers( compiler.registers )
+  {
+  }
+
+  double evaluate() override
+  {
+    return run( code.data(), registers.data() );
+  }
+
+  bool dependencies( dependencies_t& deps ) override
+  {
+    return source->dependencies( deps );
+  }
+};
+}  // unnamed
+
+void compiled_stats_t::merge( const compiled_stats_t& other )
+{
+  expressions += other.expressions;
+  instructions += other.instructions;
+  selections += other.selections;
+  timed_selections += other.timed_selections;
+  timed_seconds += other.timed_seconds;
+}
+
+double compiled_stats_t::seconds_per_selection() const
+{
+  if ( timed_selections == 0 )
+  {
+    return 0;
+  }
+
+  return timed_seconds / timed_selections;
+}
+
+// Expression result cache ==================================================
+
+void cache_stats_t::merge( const cache_stats_t& other )
+{
+  expressions += other.expressions;
+  lookups += other.lookups;
+  hits += other.hits;
+}
+
+double cache_stats_t::hit_rate() const
+{
+  return lookups ? static_cast<double>( hits ) / lookups : 0.0;
+}
+
+void dependencies_t::timed( expr_t* expression, expr_t* replaces )
+{
+  auto it = std::find( timed_expressions.begin(), timed_expressions.end(), replaces );
+  if ( replaces && it != timed_expressions.end() )
+  {
+    *it = expression;
+  }
+  else if ( std::find( timed_expressions.begin(), timed_expressions.end(), expression ) == timed_expressions.end() )
+  {
+    timed_expressions.push_back( expression );
+  }
+}
+
+result_cache_t::result_cache_t( expr_t& e, cache_stats_t& s )
+  : expression( e ),
+    stats( s ),
+    key( nullptr ),
+    collected( false ),
+    cacheable( false ),
+    valid( false ),
+    value( 0 ),
+    stored( timespan_t::zero() ),
+    expires( timespan_t::zero() )
+{
+}
+
+uint64_t result_cache_t::load( const void* address, unsigned size )
+{
+  uint64_t v = 0;
+  std::memcpy( &v, address, size );
+  return v;
+}
+
+void result_cache_t::collect( const void* k )
+{
+  dependencies_t deps;
+  cacheable = expression.dependencies( deps );
+  key = k;
+  valid = false;
+
+  if ( !collected && cacheable )
+  {
+    stats.expressions++;
+  }
+  collected = true;
+
+  watches.clear();
+  timed_expressions.clear();
+  if ( cacheable )
+  {
+    for ( const auto& w : deps.watches )
+    {
+      watches.push_back( { w.address, w.size, 0 } );
+    }
+    timed_expressions = std::move( deps.timed_expressions );
+  }
+}
+
+double result_cache_t::evaluate( timespan_t now, const void* k )
+{
+  if ( !collected || k != key )
+  {
+    collect( k );
+  }
+
+  if ( !cacheable )
+  {
+    return expression.eval();
+  }
+
+  stats.lookups++;
+
+  if ( valid && now >= stored && now < expires &&
+       std::all_of( watches.begin(), watches.end(),
+                    []( const watch_t& w ) { return load( w.address, w.size ) == w.value; } ) )
+  {
+    stats.hits++;
+    return value;
+  }
+
+  // Snapshot the inputs before evaluation, an evaluation that changes its own inputs is not reused
+  for ( auto& w : watches )
+  {
+    w.value = load( w.address, w.size );
+  }
+
+  expires = timespan_t::max();
+  for ( auto e : timed_expressions )
+  {
+    expires = std::min( expires, e->next_change( now ) );
+  }
+
+  value = expression.eval();
+  stored = now;
+  valid = true;
+
+  return value;
+}
+
 // is_unary =================================================================
 
 bool is_unary( token_e expr_token_type )
@@ -1368,6 +2008,11 @@ void expr_t::optimize_expression( std::unique_ptr<expr_t>& expression, sim_t& si
   }
   if ( sim.optimize_expressions - 1 - iterations < 0 )
   {
+    // Compile the final expression once optimization is done
+    if ( sim.apl_expression_compiler && iterations == sim.optimize_expressions )
+    {
+      compile_expression( expression, sim.apl_expression_stats );
+    }
     return;
   }
   bool analyze_further = sim.optimize_expressions - 1 - iterations  > 0;
@@ -1378,6 +2023,31 @@ void expr_t::optimize_expression( std::unique_ptr<expr_t>& expression, sim_t& si
   }
 }
 
+void expr_t::compile_expression( std::unique_ptr<expr_t>& expression, expression::compiled_stats_t& stats )
+{
+  if ( !expression || expression->is_constant() ||
+       dynamic_cast<expression::compiled_expr_t*>( expression.get() ) != nullptr )
+  {
+    return;
+  }
+
+  expression::compiler_t compiler;
+  compiler.compile( expression.get(), 0 );
+
+  // A single call gains nothing from the bytecode
+  if ( compiler.code.size() == 1 && compiler.code.front().op == expression::OP_CALL )
+  {
+    return;
+  }
+
+  compiler.add( expression::OP_RET, 0, 0 );
+
+  stats.expressions++;
+  stats.instructions += compiler.code.size();
+
+  expression = std::make_unique<expression::compiled_expr_t>( std::move( expression ), std::move( compiler ) );
+}
+
 // action_expr_t::create_constant ===========================================
 
 // action_expr_t::parse =====================================================
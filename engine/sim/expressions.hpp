@@ -6,10 +6,12 @@
 #pragma once
 
 #include "config.hpp"
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <functional>
 #include <memory>
+#include <type_traits>
 
 #include "util/timespan.hpp"
 #include "util/span.hpp"
@@ -65,6 +67,110 @@ struct expr_token_t
   std::string label;
 };
 
+/// Statistics of compiled expressions ( apl_expression_compiler=1 ). Single evaluations are too
+/// short to time, every TIMING_INTERVAL-th action selection ( a whole walk of the action priority
+/// lists, see player_t::select_action ) is timed instead.
+struct compiled_stats_t
+{
+  static constexpr uint64_t TIMING_INTERVAL = 64;
+
+  uint64_t expressions      = 0;
+  uint64_t instructions     = 0;
+  uint64_t selections       = 0;
+  uint64_t timed_selections = 0;
+  double   timed_seconds    = 0;
+
+  void merge( const compiled_stats_t& other );
+  double seconds_per_selection() const;
+};
+
+/// Evaluation statistics of cached expression results ( apl_readiness_cache=1 )
+struct cache_stats_t
+{
+  uint64_t expressions = 0;
+  uint64_t lookups     = 0;
+  uint64_t hits        = 0;
+
+  void merge( const cache_stats_t& other );
+  double hit_rate() const;
+};
+
+/// Inputs of an expression, collected by expr_t::dependencies(). The result of the expression
+/// stays the same as long as none of the watched values change, and the simulation has not reached
+/// the next change of any of the timed expressions ( see expr_t::next_change() ).
+class dependencies_t
+{
+  struct watch_t
+  {
+    const void* address;
+    unsigned size;
+  };
+
+  std::vector<watch_t> watches;
+  std::vector<expr_t*> timed_expressions;
+
+  friend class result_cache_t;
+
+public:
+  template <typename T>
+  void watch( const T& value )
+  {
+    static_assert( std::is_trivially_copyable<T>::value && sizeof( T ) <= sizeof( uint64_t ),
+                   "Watched values are compared bitwise" );
+    watches.push_back( { &value, static_cast<unsigned>( sizeof( T ) ) } );
+  }
+
+  /// Register a time dependent expression, replacing the registration of a subexpression whose
+  /// change points are covered by it.
+  void timed( expr_t* expression, expr_t* replaces = nullptr );
+};
+
+/// Result of an expression, reused while none of its dependencies change. Dependencies are
+/// collected on the first evaluation, and again whenever the evaluation context ( key, e.g.
+/// the target of the expression ) changes.
+class result_cache_t
+{
+  struct watch_t
+  {
+    const void* address;
+    unsigned size;
+    uint64_t value;
+  };
+
+  expr_t& expression;
+  cache_stats_t& stats;
+  std::vector<watch_t> watches;
+  std::vector<expr_t*> timed_expressions;
+  const void* key;
+  bool collected;
+  bool cacheable;
+  bool valid;
+  double value;
+  timespan_t stored, expires;
+
+  void collect( const void* key );
+  static uint64_t load( const void* address, unsigned size );
+
+public:
+  result_cache_t( expr_t& e, cache_stats_t& s );
+
+  double evaluate( timespan_t now, const void* key );
+  bool success( timespan_t now, const void* key )
+  { return evaluate( now, key ) != 0; }
+
+  /// Drop the cached result, required whenever the simulation time is reset
+  void invalidate()
+  { valid = false; }
+
+};
+
+class compiler_t;
+
+/// Reference expression loads of compiled expressions, see ref_expr_t
+void emit_load( compiler_t&, unsigned reg, const double* );
+void emit_load( compiler_t&, unsigned reg, const int* );
+void emit_load( compiler_t&, unsigned reg, const bool* );
+
 bool is_unary( token_e );
 bool is_binary( token_e );
 std::vector<expr_token_t> parse_tokens( action_t* action, util::string_view expr_str );
@@ -151,6 +257,10 @@ public:
 
   static void optimize_expression(std::unique_ptr<expr_t>& expression, sim_t& sim);
 
+  /// Lower an (optimized) expression tree into bytecode evaluated by a register machine. Leaf
+  /// expressions that cannot be lowered are called from the bytecode.
+  static void compile_expression( std::unique_ptr<expr_t>& expression, expression::compiled_stats_t& stats );
+
   virtual double evaluate() = 0;
 
   virtual bool is_constant()
@@ -163,9 +273,44 @@ public:
     return false;
   }
 
+  /* Records the inputs of the expression. Returns false if the result depends on state that is
+  not tracked, the result of the expression can then not be cached.
+  */
+  virtual bool dependencies( expression::dependencies_t& )
+  {
+    return false;
+  }
+
+  /* Earliest point in time, at or after now, at which the result of a timed expression ( see
+  expression::dependencies_t::timed() ) may change even if none of its watched inputs change.
+  */
+  virtual timespan_t next_change( timespan_t now )
+  {
+    return now;
+  }
+
+  /* Countdown expressions evaluate to the seconds remaining until a point in time, or zero once
+  it has passed. Returns true and the point in time if the expression is one.
+  */
+  virtual bool countdown( timespan_t& /* end */ )
+  {
+    return false;
+  }
+
   expression::token_e op_;
 
 private:
+  friend class expression::compiler_t;
+
+  /* Emits instructions evaluating the expression into register reg, registers above reg may be
+  used as temporaries. Returns false if the expression cannot be lowered, the compiler then emits a
+  call to evaluate().
+  */
+  virtual bool emit( expression::compiler_t&, unsigned /* reg */ )
+  {
+    return false;
+  }
+
   /* Attempts to create a optimized version of the expression.
   Should return null if no improved version can be built.
   */
@@ -200,6 +345,11 @@ public:
   {
     return true;
   }
+
+  bool dependencies( expression::dependencies_t& ) override
+  {
+    return true;
+  }
 };
 
 // Reference Expression - ref_expr_t
@@ -219,6 +369,32 @@ private:
   {
     return coerce( t );
   }
+
+  bool emit( expression::compiler_t& compiler, unsigned reg ) override
+  {
+    if constexpr ( std::is_same_v<T, double> || std::is_same_v<T, int> || std::is_same_v<T, bool> )
+    {
+      expression::emit_load( compiler, reg, &t );
+      return true;
+    }
+    else
+    {
+      return false;
+    }
+  }
+
+  bool dependencies( expression::dependencies_t& deps ) override
+  {
+    if constexpr ( std::is_trivially_copyable<T>::value && sizeof( T ) <= sizeof( uint64_t ) )
+    {
+      deps.watch( t );
+      return true;
+    }
+    else
+    {
+      return false;
+    }
+  }
 };
 
 // Template to return a reference expression
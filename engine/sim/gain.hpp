@@ -39,4 +39,8 @@ public:
     { actual[ i ] /= iterations; overflow[ i ] /= iterations; count[ i ] /= iterations; }
   }
   const std::string& name() const { return name_str; }
+
+  template <typename Archive>
+  void serialize( Archive& ar )
+  { ar( actual, overflow, count ); }
 };
\ No newline at end of file
@@ -35,6 +35,10 @@ public:
 
   void merge(const proc_t& other);
 
+  template <typename Archive>
+  void serialize( Archive& ar )
+  { ar( interval_sum, count ); }
+
   void analyze();
 
   void datacollection_begin();
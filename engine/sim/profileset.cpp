@@ -104,20 +104,9 @@ std::string format_time( double seconds, bool milliseconds = true )
 
 // Deallocating profile_sim is the responsibility of the caller (i.e., profileset driver or
 // worker_t)
-void simulate_profileset( sim_t* parent, profileset::profile_set_t& set, sim_t*& profile_sim )
+void simulate_profileset( sim_t* parent, profileset::profile_set_t& set, sim_t*& profile_sim, bool last_round )
 {
-  // Reset random seed for the profileset sims
-  profile_sim -> seed = 0;
-  profile_sim -> profileset_enabled = true;
-  profile_sim -> report_details = 0;
-  if ( parent -> profileset_work_threads > 0 )
-  {
-    profile_sim -> threads = parent -> profileset_work_threads;
-    // Disable reporting on parallel sims, instead, rely on parallel sims finishing to report
-    // progress. For normal profileset simming we can rely on the normal progressbar updates
-    profile_sim -> report_progress = false;
-  }
-  else
+  if ( parent -> profileset_work_threads == 0 )
   {
     profile_sim -> progress_bar.set_base( "Profileset" );
     profile_sim -> progress_bar.set_phase( set.name() );
@@ -128,7 +117,8 @@ void simulate_profileset( sim_t* parent, profileset::profile_set_t& set, sim_t*&
   {
     profile_sim -> progress_bar.restart();
 
-    if ( set.has_output() )
+    // Racing rounds are not reported, the last round simulates the profileset in full
+    if ( set.has_output() && last_round )
     {
       report::print_suite( profile_sim );
     }
@@ -142,6 +132,8 @@ void simulate_profileset( sim_t* parent, profileset::profile_set_t& set, sim_t*&
   const auto player = profile_sim -> player_no_pet_list[ parent->profileset_report_player_index ];
   auto progress = profile_sim -> progress( nullptr, 0 );
 
+  set.add_iterations( progress.current_iterations );
+
   range::for_each( parent -> profileset_metric, [ & ]( scale_metric_e metric ) {
     auto data = profileset::metric_data( player, metric );
 
@@ -155,6 +147,23 @@ void simulate_profileset( sim_t* parent, profileset::profile_set_t& set, sim_t*&
       .stddev( data.std_dev )
       .mean_stddev( data.mean_std_dev )
       .iterations( progress.current_iterations );
+
+    // Pair the iterations with the baseline iterations that used the same random numbers
+    if ( parent -> common_rng )
+    {
+      const auto parent_player = parent -> player_no_pet_list[ parent->profileset_report_player_index ];
+      auto base_data = parent_player -> collected_data.metric_sample_data( metric );
+      auto profile_data = player -> collected_data.metric_sample_data( metric );
+      if ( base_data && profile_data )
+      {
+        auto paired = statistics::paired_difference( parent_player -> collected_data.iteration_keys, base_data -> data(),
+                                                     player -> collected_data.iteration_keys, profile_data -> data() );
+        set.result( metric )
+          .paired_delta( paired.mean )
+          .paired_delta_stddev( paired.mean_std_dev )
+          .variance_reduction( paired.variance_reduction );
+      }
+    }
   } );
 
   if ( ! parent -> profileset_output_data.empty() )
@@ -170,9 +179,20 @@ void simulate_profileset( sim_t* parent, profileset::profile_set_t& set, sim_t*&
   parent -> init_time    += profile_sim -> init_time;
   parent -> merge_time   += profile_sim -> merge_time;
   parent -> analyze_time += profile_sim -> analyze_time;
+  parent -> analyze_buff_time  += profile_sim -> analyze_buff_time;
+  parent -> analyze_stats_time += profile_sim -> analyze_stats_time;
+  parent -> analyze_actor_time += profile_sim -> analyze_actor_time;
   parent -> event_mgr.total_events_processed += profile_sim -> event_mgr.total_events_processed;
 
-  set.cleanup_options();
+  // Racing rounds simulate the profileset again later
+  if ( last_round )
+  {
+    set.cleanup_options();
+  }
+  else
+  {
+    set.release_options();
+  }
 }
 
 // Figure out if the option defines new actor(s) with their own scope
@@ -193,6 +213,33 @@ bool is_actor_scope( const option_tuple_t& opt )
 
 namespace profileset
 {
+sim_t* create_sim( sim_t* parent, sim_control_t* control, int iterations )
+{
+  auto profile_sim = new sim_t( parent, 0, control );
+
+  // Reset random seed for the profileset sims, common random numbers share the baseline seed
+  profile_sim -> seed = parent -> common_rng ? parent -> seed : 0;
+  profile_sim -> profileset_enabled = true;
+  profile_sim -> report_details = 0;
+  if ( parent -> profileset_work_threads > 0 )
+  {
+    profile_sim -> threads = parent -> profileset_work_threads;
+    // Disable reporting on parallel sims, instead, rely on parallel sims finishing to report
+    // progress. For normal profileset simming we can rely on the normal progressbar updates
+    profile_sim -> report_progress = false;
+  }
+
+  // Racing rounds simulate a fixed number of iterations
+  if ( iterations > 0 )
+  {
+    profile_sim -> iterations = iterations;
+    profile_sim -> target_error = 0;
+    profile_sim -> work_queue -> init( iterations );
+  }
+
+  return profile_sim;
+}
+
 size_t profilesets_t::done_profilesets() const
 {
   if ( m_work_index <= n_workers() )
@@ -203,9 +250,9 @@ size_t profilesets_t::done_profilesets() const
   return m_work_index - n_workers();
 }
 
-sim_control_t* profilesets_t::create_sim_options( const sim_control_t*            original,
-                                                  const std::vector<std::string>& opts,
-                                                  unsigned main_actor_index )
+std::unique_ptr<profile_options_t> profilesets_t::create_sim_options(
+    const std::shared_ptr<const sim_control_t>& original, const std::vector<std::string>& opts,
+    unsigned main_actor_index )
 {
   if ( original == nullptr )
   {
@@ -250,13 +297,12 @@ sim_control_t* profilesets_t::create_sim_options( const sim_control_t*
     m_actor_indices.push_back( original->options.size() );
   }
 
-  auto options_copy = new sim_control_t( *original );
-  std::vector<option_tuple_t> filtered_opts;
-
   // Filter profileset options so that any option overridable in the base options is
-  // overriden, and the rest are inserted at the correct position
+  // overriden, and the rest are inserted at the correct position. The base options are shared
+  // by all profilesets, only the overrides are stored per profileset.
   size_t profileset_actor_start_index = m_actor_indices[ main_actor_index ];
   size_t profileset_actor_end_index = m_actor_indices[ main_actor_index + 1 ];
+  auto profile_options = std::make_unique<profile_options_t>( original, profileset_actor_end_index );
   for ( const option_tuple_t& t : new_options.options )
   {
     if ( is_actor_scope( t ) )
@@ -267,42 +313,76 @@ sim_control_t* profilesets_t::create_sim_options( const sim_control_t*
 
     if ( !overridable_option( t ) )
     {
-      filtered_opts.push_back( t );
+      profile_options->insert_option( t );
     }
-    // Option that can be overridden in the copy, check if it exists in the base options
-    // set and replace if so
+    // Option that can be overridden, check if it exists in the base options set and replace if
+    // so
     else
     {
       // Note, replace the last occurrence of the option to ensure the profileset option will be set
-      auto end_it = std::reverse_iterator( options_copy->options.begin() + profileset_actor_start_index );
-      auto start_it = std::reverse_iterator( options_copy->options.begin() + profileset_actor_end_index );
+      auto end_it = std::reverse_iterator( original->options.begin() + profileset_actor_start_index );
+      auto start_it = std::reverse_iterator( original->options.begin() + profileset_actor_end_index );
       auto it = std::find_if( start_it, end_it, [&t]( const option_tuple_t& orig_t ) { return orig_t.name == t.name; } );
       if ( it != end_it )
-        it->value = t.value;
+        profile_options->override_option( std::distance( original->options.begin(), it.base() ) - 1, t.value );
       else
-        filtered_opts.push_back( t );
+        profile_options->insert_option( t );
     }
   }
 
-  options_copy -> options.insert( options_copy -> options.begin() + profileset_actor_end_index,
-                                  filtered_opts.begin(), filtered_opts.end() );
+  return profile_options;
+}
+
+profile_options_t::profile_options_t( std::shared_ptr<const sim_control_t> base, size_t insert_index ) :
+  m_base( std::move( base ) ), m_insert_index( insert_index )
+{
+}
+
+sim_control_t* profile_options_t::materialize() const
+{
+  auto control = new sim_control_t();
+  control -> combat = m_base -> combat;
+  control -> players = m_base -> players;
+  control -> options.auto_path = m_base -> options.auto_path;
+  control -> options.var_map = m_base -> options.var_map;
+
+  control -> options.reserve( m_base -> options.size() + m_inserted.size() );
+  control -> options.insert( control -> options.end(), m_base -> options.begin(),
+                             m_base -> options.begin() + m_insert_index );
+  control -> options.insert( control -> options.end(), m_inserted.begin(), m_inserted.end() );
+  control -> options.insert( control -> options.end(), m_base -> options.begin() + m_insert_index,
+                             m_base -> options.end() );
+
+  // Overridden options all precede the insertion point
+  for ( const auto& entry : m_overrides )
+  {
+    control -> options[ entry.first ].value = entry.second;
+  }
 
-  return options_copy;
+  return control;
 }
 
+
 profilesets_t::profilesets_t() : m_state( STARTED ), m_mode( SEQUENTIAL ),
     m_original( nullptr ), m_actor_indices(),
     m_work_index( 0 ),
     m_control_lock( m_mutex, std::defer_lock ),
+    m_max_prepared( 0 ),
+    m_round_iterations( 0 ),
     m_max_workers( 0 ), 
     m_work_lock( m_work_mutex, std::defer_lock ),
-    m_total_elapsed()
+    m_total_elapsed(),
+    m_init_elapsed(),
+    m_n_reused( 0 )
 { 
 
 }
 
 profilesets_t::~profilesets_t()
 {
+  // Release init workers waiting for the queue of initialized sims to drain
+  set_state( DONE );
+
   range::for_each( m_thread, []( std::thread& thread ) {
     if ( thread.joinable() )
     {
@@ -313,27 +393,55 @@ profilesets_t::~profilesets_t()
   range::for_each( m_current_work, []( std::unique_ptr<worker_t>& worker ) { worker -> thread().join(); } );
 }
 
-profile_set_t::profile_set_t( std::string name, sim_control_t* opts, bool has_output ) :
-  m_name( std::move(name) ), m_options( opts ), m_has_output( has_output ), m_output_data( nullptr )
+profile_set_t::profile_set_t( std::string name, std::unique_ptr<profile_options_t> opts, bool has_output,
+                              sim_t* prepared, sim_control_t* prepared_opts ) :
+  m_name( std::move(name) ), m_overrides( std::move( opts ) ), m_options( prepared_opts ),
+  m_has_output( has_output ), m_output_data( nullptr ), m_sim( prepared ), m_total_iterations( 0 ),
+  m_eliminated_round( -1 )
 {
 }
 
-sim_control_t* profile_set_t::options() const
+sim_control_t* profile_set_t::options()
 {
+  if ( ! m_options && m_overrides )
+  {
+    m_options = m_overrides -> materialize();
+  }
+
   return m_options;
 }
 
-void profile_set_t::cleanup_options()
+void profile_set_t::release_options()
 {
   delete m_options;
   m_options = nullptr;
 }
 
+void profile_set_t::cleanup_options()
+{
+  release_options();
+  m_overrides.reset();
+}
+
 profile_set_t::~profile_set_t()
 {
+  delete m_sim;
   delete m_options;
 }
 
+void profile_set_t::eliminate( int round )
+{
+  m_eliminated_round = round;
+  cleanup_options();
+}
+
+sim_t* profile_set_t::release_sim()
+{
+  auto sim = m_sim;
+  m_sim = nullptr;
+  return sim;
+}
+
 const profile_result_t& profile_set_t::result( scale_metric_e metric ) const
 {
   static const profile_result_t __default {};
@@ -378,9 +486,9 @@ profile_result_t& profile_set_t::result( scale_metric_e metric )
   return m_results.back();
 }
 
-worker_t::worker_t( profilesets_t* master, sim_t* p, profile_set_t* ps ) :
+worker_t::worker_t( profilesets_t* master, sim_t* p, profile_set_t* ps, int iterations ) :
   m_done( false ), m_parent( p ), m_master( master ), m_sim( nullptr ), m_profileset( ps ),
-  m_thread( nullptr )
+  m_iterations( iterations ), m_thread( nullptr )
 {
   m_thread = new std::thread( [this] { execute(); } );
 }
@@ -410,9 +518,19 @@ void worker_t::execute()
 {
   try
   {
-    m_sim = new sim_t( m_parent, 0, m_profileset -> options() );
+    m_sim = m_profileset -> release_sim();
+    if ( m_sim )
+    {
+      m_master -> add_init_time( chrono::wall_clock::duration::zero(), true );
+    }
+    else
+    {
+      auto start = chrono::wall_clock::now();
+      m_sim = create_sim( m_parent, m_profileset -> options(), m_iterations );
+      m_master -> add_init_time( chrono::elapsed( start ) );
+    }
 
-    simulate_profileset( m_parent, *m_profileset, m_sim );
+    simulate_profileset( m_parent, *m_profileset, m_sim, m_iterations == 0 );
   }
   catch (const std::exception& e )
   {
@@ -496,15 +614,19 @@ void profilesets_t::generate_work( sim_t* parent, std::unique_ptr<profile_set_t>
 {
   if ( m_mode == SEQUENTIAL )
   {
-    auto original_opts = parent -> control;
-
-    parent -> control = ptr_set -> options();
-
-    sim_t* profile_sim = new sim_t( parent );
-
-    parent -> control = original_opts;
+    sim_t* profile_sim = ptr_set -> release_sim();
+    if ( profile_sim )
+    {
+      add_init_time( chrono::wall_clock::duration::zero(), true );
+    }
+    else
+    {
+      auto start = chrono::wall_clock::now();
+      profile_sim = create_sim( parent, ptr_set -> options(), m_round_iterations );
+      add_init_time( chrono::elapsed( start ) );
+    }
 
-    simulate_profileset( parent, *ptr_set, profile_sim );
+    simulate_profileset( parent, *ptr_set, profile_sim, m_round_iterations == 0 );
 
     delete profile_sim;
   }
@@ -525,7 +647,7 @@ void profilesets_t::generate_work( sim_t* parent, std::unique_ptr<profile_set_t>
       // Output profileset progressbar whenever we finish anything
       output_progressbar( parent );
 
-      m_current_work.push_back( std::make_unique<worker_t>( this, parent, ptr_set.get() ) );
+      m_current_work.push_back( std::make_unique<worker_t>( this, parent, ptr_set.get(), m_round_iterations ) );
     }
 
     m_work_lock.unlock();
@@ -545,7 +667,11 @@ bool profilesets_t::parse( sim_t* sim )
       return false;
     }
 
-    m_mutex.lock();
+    if ( ! wait_prepared( sim ) )
+    {
+      m_control.notify_one();
+      return ! sim -> canceled;
+    }
 
     if ( m_init_index == sim -> profileset_map.cend() )
     {
@@ -560,8 +686,8 @@ bool profilesets_t::parse( sim_t* sim )
 
     m_mutex.unlock();
 
-    auto control = create_sim_options( m_original.get(), profileset_opts, sim->profileset_main_actor_index );
-    if ( control == nullptr )
+    auto profile_options = create_sim_options( m_original, profileset_opts, sim->profileset_main_actor_index );
+    if ( profile_options == nullptr )
     {
       set_state( DONE );
       m_control.notify_one();
@@ -582,14 +708,30 @@ bool profilesets_t::parse( sim_t* sim )
              util::str_compare_ci( name, "json2" );
     } );
 
-    // Test that profileset options are OK, up to the simulation initialization
+    // Test that profileset options are OK, up to the simulation initialization. When reusing
+    // init, the validated sim is kept and simulated later, instead of initializing a new one.
+    // Otherwise the materialized options are released after validation, and materialized again
+    // when the profileset is simulated.
+    std::unique_ptr<sim_control_t> control( profile_options -> materialize() );
+    sim_t* prepared = nullptr;
     try
     {
-      std::unique_ptr<sim_t> test_sim = std::make_unique<sim_t>();
-      test_sim -> profileset_enabled = true;
+      auto start = chrono::wall_clock::now();
+      if ( sim -> profileset_reuse_init )
+      {
+        std::unique_ptr<sim_t> profile_sim( create_sim( sim, control.get(), m_round_iterations ) );
+        profile_sim -> init();
+        prepared = profile_sim.release();
+      }
+      else
+      {
+        std::unique_ptr<sim_t> test_sim = std::make_unique<sim_t>();
+        test_sim -> profileset_enabled = true;
 
-      test_sim -> setup( control );
-      test_sim -> init();
+        test_sim -> setup( control.get() );
+        test_sim -> init();
+      }
+      add_init_time( chrono::elapsed( start ) );
     }
     catch ( const std::exception& e )
     {
@@ -598,13 +740,12 @@ bool profilesets_t::parse( sim_t* sim )
       fmt::print( stderr, "\n" );
       set_state( DONE );
       m_control.notify_one();
-      delete control;
       return false;
     }
 
     m_mutex.lock();
-    m_profilesets.push_back( std::make_unique<profile_set_t>(
-        profileset_name, control, has_output_opts ) );
+    m_profilesets.push_back( std::make_unique<profile_set_t>( profileset_name, std::move( profile_options ),
+        has_output_opts, prepared, prepared ? control.release() : nullptr ) );
     m_control.notify_one();
     m_mutex.unlock();
   }
@@ -660,17 +801,35 @@ void profilesets_t::initialize( sim_t* sim )
     m_mode = PARALLEL;
   }
 
+  // Racing only pays off when there are profilesets to eliminate, with at most
+  // profileset_race_top profilesets every one of them would be simulated again in full
+  if ( sim -> profileset_race_iterations > 0 &&
+       sim -> profileset_map.size() > as<size_t>( std::max( 1, sim -> profileset_race_top ) ) )
+  {
+    m_round_iterations = sim -> profileset_race_iterations;
+  }
+
+  // Initialized profileset sims are kept until simulated, only run ahead of the workers enough to
+  // keep them busy
+  if ( sim -> profileset_reuse_init )
+  {
+    m_max_prepared = std::max( m_max_workers, size_t( 1 ) ) + as<size_t>( sim -> profileset_init_threads );
+  }
+
   m_profilesets.reserve( sim -> profileset_map.size() + 1 );
 
   // Generate a copy of the original control, and remove any and all profileset. options from it
-  m_original = std::make_unique<sim_control_t>( );
+  auto original = std::make_shared<sim_control_t>( );
 
-  // Copy non-profileset. options to use as a base option setup for each profileset
-  range::copy_if( sim -> control -> options, std::back_inserter( m_original -> options ),
+  // Copy non-profileset. options to use as a base option setup for each profileset, the base
+  // options are shared by all profilesets and never modified
+  range::copy_if( sim -> control -> options, std::back_inserter( original -> options ),
     []( const option_tuple_t& opt ) {
     return ! util::str_in_str_ci( opt.name, "profileset." );
   } );
 
+  m_original = std::move( original );
+
   // Spawn initialization threads, and start parsing through the profilesets
   set_state( INITIALIZING );
 
@@ -691,6 +850,11 @@ void profilesets_t::cancel()
 {
   if ( ! is_done() )
   {
+    // Wake up init workers waiting for the simulation of queued profilesets
+    m_mutex.lock();
+    m_mutex.unlock();
+    m_prepared.notify_all();
+
     range::for_each( m_thread, []( std::thread& thread ) {
       if ( thread.joinable() )
       {
@@ -709,6 +873,56 @@ void profilesets_t::set_state( state new_state )
   m_state = new_state;
 
   m_mutex.unlock();
+
+  m_prepared.notify_all();
+}
+
+// Locks m_mutex, and waits until there is room for another initialized profileset sim. Returns
+// false (with m_mutex unlocked) if profilesets got canceled or finished while waiting.
+bool profilesets_t::wait_prepared( const sim_t* sim )
+{
+  std::unique_lock<std::mutex> lock( m_mutex );
+
+  if ( m_max_prepared > 0 )
+  {
+    m_prepared.wait( lock, [ this, sim ] {
+      return sim -> canceled || is_done() || m_profilesets.size() - m_work_index < m_max_prepared;
+    } );
+  }
+
+  if ( sim -> canceled || is_done() )
+  {
+    return false;
+  }
+
+  lock.release();
+
+  return true;
+}
+
+void profilesets_t::add_init_time( chrono::wall_clock::duration d, bool reused )
+{
+  std::lock_guard<std::mutex> lock( m_stats_mutex );
+
+  m_init_elapsed += d;
+  if ( reused )
+  {
+    ++m_n_reused;
+  }
+}
+
+chrono::wall_clock::duration profilesets_t::init_elapsed() const
+{
+  std::lock_guard<std::mutex> lock( m_stats_mutex );
+
+  return m_init_elapsed;
+}
+
+size_t profilesets_t::n_reused() const
+{
+  std::lock_guard<std::mutex> lock( m_stats_mutex );
+
+  return m_n_reused;
 }
 
 std::string profilesets_t::current_profileset_name()
@@ -761,6 +975,8 @@ bool profilesets_t::iterate( sim_t* parent )
 
     m_control_lock.unlock();
 
+    m_prepared.notify_all();
+
     generate_work( parent, set );
   }
 
@@ -768,6 +984,8 @@ bool profilesets_t::iterate( sim_t* parent )
   // not need to finalize any work (all work has been done by the loop above)
   finalize_work();
 
+  race( parent );
+
   // Output profileset progressbar whenever we finish anything
   output_progressbar( parent );
 
@@ -781,6 +999,94 @@ bool profilesets_t::iterate( sim_t* parent )
   return true;
 }
 
+// Eliminate the profilesets whose confidence interval of the primary metric lies below the
+// interval of the profileset ranked profileset_race_top. Returns the number of remaining
+// profilesets.
+size_t profilesets_t::eliminate( const sim_t* parent, int round )
+{
+  std::vector<profile_set_t*> alive;
+  range::for_each( m_profilesets, [ &alive ]( const profileset_entry_t& set ) {
+    if ( ! set -> eliminated() )
+    {
+      alive.push_back( set.get() );
+    }
+  } );
+
+  size_t top = as<size_t>( std::max( 1, parent -> profileset_race_top ) );
+  if ( alive.size() <= top )
+  {
+    return alive.size();
+  }
+
+  range::sort( alive, []( const profile_set_t* l, const profile_set_t* r ) {
+    return l -> result().mean() > r -> result().mean();
+  } );
+
+  const auto& last_top = alive[ top - 1 ] -> result();
+  double threshold = last_top.mean() - parent -> confidence_estimator * last_top.mean_stddev();
+  size_t n_alive = alive.size();
+
+  for ( size_t i = top; i < alive.size(); ++i )
+  {
+    const auto& result = alive[ i ] -> result();
+    if ( result.mean() + parent -> confidence_estimator * result.mean_stddev() < threshold )
+    {
+      alive[ i ] -> eliminate( round );
+      --n_alive;
+    }
+  }
+
+  return n_alive;
+}
+
+// Successive racing rounds. Every round eliminates the profilesets that are clearly behind the top
+// profilesets, and simulates the remaining ones with four times the iterations of the previous
+// round. The final round simulates the remaining profilesets normally.
+void profilesets_t::race( sim_t* parent )
+{
+  if ( m_round_iterations == 0 )
+  {
+    return;
+  }
+
+  for ( int round = 0; ! parent -> canceled; ++round )
+  {
+    auto n_alive = eliminate( parent, round );
+    bool last_round = n_alive <= as<size_t>( std::max( 1, parent -> profileset_race_top ) ) ||
+                      round + 1 >= parent -> profileset_race_rounds;
+
+    // A round of as many iterations as the normal simulation is the final round. Computed in 64 bits,
+    // so that many rounds of many iterations do not overflow
+    int64_t next_iterations = static_cast<int64_t>( m_round_iterations ) * 4;
+    if ( next_iterations >= parent -> iterations )
+    {
+      last_round = true;
+    }
+
+    m_round_iterations = last_round ? 0 : as<int>( next_iterations );
+
+    for ( auto& set : m_profilesets )
+    {
+      if ( parent -> canceled )
+      {
+        break;
+      }
+
+      if ( ! set -> eliminated() )
+      {
+        generate_work( parent, set );
+      }
+    }
+
+    finalize_work();
+
+    if ( last_round )
+    {
+      break;
+    }
+  }
+}
+
 void profilesets_t::notify_worker()
 {
   m_work.notify_one();
@@ -954,6 +1260,10 @@ void create_options( sim_t* sim )
 
   sim -> add_option( opt_int( "profileset_work_threads", sim -> profileset_work_threads ) );
   sim -> add_option( opt_int( "profileset_init_threads", sim -> profileset_init_threads ) );
+  sim -> add_option( opt_bool( "profileset_reuse_init", sim -> profileset_reuse_init ) );
+  sim -> add_option( opt_int( "profileset_race_iterations", sim -> profileset_race_iterations, 0, std::numeric_limits<int>::max() ) );
+  sim -> add_option( opt_int( "profileset_race_rounds", sim -> profileset_race_rounds, 1, std::numeric_limits<int>::max() ) );
+  sim -> add_option( opt_int( "profileset_race_top", sim -> profileset_race_top, 1, std::numeric_limits<int>::max() ) );
 }
 
 statistical_data_t collect( const extended_sample_data_t& c )
@@ -1150,6 +1460,9 @@ void profilesets_t::cancel() {}
 bool profilesets_t::iterate( sim_t*  ) { return true ;}
 void profilesets_t::output_html( const sim_t&, std::ostream& ) const {}
 void profilesets_t::output_text( const sim_t&, std::ostream& ) const {}
+void profilesets_t::add_init_time( chrono::wall_clock::duration, bool ) {}
+chrono::wall_clock::duration profilesets_t::init_elapsed() const { return {}; }
+size_t profilesets_t::n_reused() const { return 0; }
 size_t profilesets_t::n_profilesets() const { return 0; }
 bool profilesets_t::is_running() const { return false; }
 }
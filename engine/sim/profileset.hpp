@@ -9,6 +9,7 @@
 #include <memory>
 #include <vector>
 #include <string>
+#include <utility>
 
 #ifndef SC_NO_THREADING
 #include <thread>
@@ -33,6 +34,7 @@ namespace profileset
 class profilesets_t;
 
 #ifdef SC_NO_THREADING
+class profile_options_t;
 class profile_set_t;
 class profile_output_data_t;
 struct statistical_data_t;
@@ -56,14 +58,20 @@ class profile_result_t
   double         m_stddev;
   double         m_mean_stddev;
   size_t         m_iterations;
+  // Difference to the baseline actor, paired by iteration ( common_rng=1 )
+  double         m_paired_delta;
+  double         m_paired_delta_stddev;
+  double         m_variance_reduction;
 
 public:
   profile_result_t() : m_metric( SCALE_METRIC_NONE ), m_mean( 0 ), m_median( 0 ), m_min( 0 ),
-    m_max( 0 ), m_1stquartile( 0 ), m_3rdquartile( 0 ), m_stddev( 0 ), m_mean_stddev(0), m_iterations( 0 )
+    m_max( 0 ), m_1stquartile( 0 ), m_3rdquartile( 0 ), m_stddev( 0 ), m_mean_stddev(0), m_iterations( 0 ),
+    m_paired_delta( 0 ), m_paired_delta_stddev( 0 ), m_variance_reduction( 0 )
   { }
 
   profile_result_t( scale_metric_e m ) : m_metric( m ), m_mean( 0 ), m_median( 0 ), m_min( 0 ),
-    m_max( 0 ), m_1stquartile( 0 ), m_3rdquartile( 0 ), m_stddev( 0 ), m_mean_stddev(0), m_iterations( 0 )
+    m_max( 0 ), m_1stquartile( 0 ), m_3rdquartile( 0 ), m_stddev( 0 ), m_mean_stddev(0), m_iterations( 0 ),
+    m_paired_delta( 0 ), m_paired_delta_stddev( 0 ), m_variance_reduction( 0 )
   { }
 
   scale_metric_e metric() const
@@ -127,6 +135,27 @@ public:
   profile_result_t& iterations( size_t i )
   { m_iterations = i; return *this; }
 
+  bool paired() const
+  { return m_variance_reduction > 0; }
+
+  double paired_delta() const
+  { return m_paired_delta; }
+
+  profile_result_t& paired_delta( double v )
+  { m_paired_delta = v; return *this; }
+
+  double paired_delta_stddev() const
+  { return m_paired_delta_stddev; }
+
+  profile_result_t& paired_delta_stddev( double v )
+  { m_paired_delta_stddev = v; return *this; }
+
+  double variance_reduction() const
+  { return m_variance_reduction; }
+
+  profile_result_t& variance_reduction( double v )
+  { m_variance_reduction = v; return *this; }
+
   statistical_data_t statistical_data() const
   { return { m_min, m_1stquartile, m_median, m_mean, m_3rdquartile, m_max, m_stddev, m_mean_stddev }; }
 };
@@ -376,25 +405,80 @@ public:
   { m_corruption_resistance = d; return *this; }
 };
 
+// Options of a profileset, stored as overrides of the base options shared by all profilesets. The
+// full control object is materialized only while the profileset sim is set up and simulated.
+class profile_options_t
+{
+  std::shared_ptr<const sim_control_t>        m_base;
+  // Base options ( by index ) whose value the profileset overrides, applied in order
+  std::vector<std::pair<size_t, std::string>> m_overrides;
+  // Profileset options inserted into the base options at m_insert_index
+  std::vector<option_tuple_t>                 m_inserted;
+  size_t                                      m_insert_index;
+
+public:
+  profile_options_t( std::shared_ptr<const sim_control_t> base, size_t insert_index );
+
+  void override_option( size_t index, std::string value )
+  { m_overrides.emplace_back( index, std::move( value ) ); }
+
+  void insert_option( const option_tuple_t& option )
+  { m_inserted.push_back( option ); }
+
+  // Build the full control object of the profileset, caller is responsible for deleting it
+  sim_control_t* materialize() const;
+};
+
 class profile_set_t
 {
   std::string                            m_name;
+  std::unique_ptr<profile_options_t>     m_overrides;
+  // Materialized options, only exist while the profileset sim needs them
   sim_control_t*                         m_options;
   bool                                   m_has_output;
   std::vector<profile_result_t>          m_results;
   std::unique_ptr<profile_output_data_t> m_output_data;
+  // Simulator object initialized during profileset validation, if reused
+  sim_t*                                 m_sim;
+  // Iterations simulated over all racing rounds
+  size_t                                 m_total_iterations;
+  // Racing round after which the profileset was eliminated, -1 if not eliminated
+  int                                    m_eliminated_round;
 
 public:
-  profile_set_t( std::string name, sim_control_t* opts, bool has_output );
+  profile_set_t( std::string name, std::unique_ptr<profile_options_t> opts, bool has_output, sim_t* prepared = nullptr,
+                 sim_control_t* prepared_opts = nullptr );
 
   ~profile_set_t();
 
+  // Release the materialized options, they are materialized again if the profileset is simulated again
+  void release_options();
+
+  // Release all options, the profileset will not be simulated again
   void cleanup_options();
 
+  // Transfer ownership of the initialized simulator object to the caller, nullptr if none
+  sim_t* release_sim();
+
   const std::string& name() const
   { return m_name; }
 
-  sim_control_t* options() const;
+  // Materialized options of the profileset
+  sim_control_t* options();
+
+  size_t total_iterations() const
+  { return m_total_iterations; }
+
+  void add_iterations( size_t i )
+  { m_total_iterations += i; }
+
+  bool eliminated() const
+  { return m_eliminated_round > -1; }
+
+  int eliminated_round() const
+  { return m_eliminated_round; }
+
+  void eliminate( int round );
 
   bool has_output() const
   { return m_has_output; }
@@ -425,10 +509,11 @@ class worker_t
 
   sim_t*         m_sim;
   profile_set_t* m_profileset;
+  int            m_iterations;
   std::thread*   m_thread;
 
 public:
-  worker_t( profilesets_t*, sim_t*, profile_set_t* );
+  worker_t( profilesets_t*, sim_t*, profile_set_t*, int iterations );
   ~worker_t();
 
   const std::thread& thread() const;
@@ -466,7 +551,7 @@ private:
   state                                  m_state;
   simulation_mode                        m_mode;
   profileset_vector_t                    m_profilesets;
-  std::unique_ptr<sim_control_t>         m_original;
+  std::shared_ptr<const sim_control_t>   m_original;
   std::vector<size_t>                    m_actor_indices;
   size_t                                 m_work_index;
   std::mutex                             m_mutex;
@@ -474,6 +559,13 @@ private:
   std::condition_variable                m_control;
   std::vector<std::thread>               m_thread;
 
+  // Init workers wait here when enough initialized profileset sims are queued
+  std::condition_variable                m_prepared;
+  size_t                                 m_max_prepared;
+
+  // Fixed iteration count of the current racing round, 0 when simulating normally
+  int                                    m_round_iterations;
+
   // Shared iterator for threaded init workers
   opts::map_list_t::const_iterator       m_init_index;
 
@@ -489,6 +581,11 @@ private:
   // Parallel profileset stats collection
   chrono::wall_clock::time_point         m_start_time;
   chrono::wall_clock::duration           m_total_elapsed;
+
+  // Setup and init cost of the profileset sims, including validation
+  mutable std::mutex                     m_stats_mutex;
+  chrono::wall_clock::duration           m_init_elapsed;
+  size_t                                 m_n_reused;
 #endif
 
   int max_name_length() const;
@@ -501,8 +598,12 @@ private:
   void generate_work( sim_t*, std::unique_ptr<profile_set_t>& );
   void cleanup_work();
   void finalize_work();
+  size_t eliminate( const sim_t*, int round );
+  void race( sim_t* );
 
-  sim_control_t* create_sim_options( const sim_control_t*, const std::vector<std::string>& opts, unsigned main_actor_index );
+  std::unique_ptr<profile_options_t> create_sim_options( const std::shared_ptr<const sim_control_t>&,
+                                                         const std::vector<std::string>& opts, unsigned main_actor_index );
+  bool wait_prepared( const sim_t* );
 public:
   profilesets_t();
 
@@ -517,6 +618,14 @@ public:
   // Worker sim finished
   void notify_worker();
 
+  // Record the setup and init time of a profileset sim
+  void add_init_time( chrono::wall_clock::duration, bool reused = false );
+
+  chrono::wall_clock::duration init_elapsed() const;
+
+  // Number of profilesets simulated with the sim initialized during validation
+  size_t n_reused() const;
+
   std::string current_profileset_name();
 
   bool parse( sim_t* );
@@ -546,6 +655,9 @@ void save_output_data( profile_set_t& profileset, const player_t* parent_player,
 // Filter non-profilest options into a new control object, caller is responsible for deleting the
 // newly created control object.
 sim_control_t* filter_control( const sim_control_t* );
+
+// Create the simulator object for a profileset, caller is responsible for deleting it
+sim_t* create_sim( sim_t* parent, sim_control_t* control, int iterations = 0 );
 } /* Namespace profileset ends */
 
 #endif /* SC_PROFILESET_HH */
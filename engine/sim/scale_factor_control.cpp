@@ -13,7 +13,10 @@
 #include "report/reports.hpp"
 #include "util/util.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <memory>
+#include <thread>
 
 namespace { // UNNAMED NAMESPACE ==========================================
 
@@ -134,6 +137,7 @@ scale_factor_control_t::scale_factor_control_t( sim_t* s ) :
   scale_factor_noise( 0.10 ),
   normalize_scale_factors( 0 ),
   debug_scale_factors( 0 ),
+  work_threads( 0 ),
   current_scaling_stat( STAT_NONE ),
   num_scaling_stats( 0 ),
   remaining_scaling_stats( 0 ),
@@ -171,11 +175,17 @@ double scale_factor_control_t::progress( std::string& phase, std::string* detail
 
   double divisor = num_scaling_stats * 2.0;
 
-  if ( ref_sim  ) stat_progress += divisor * ref_sim  -> progress().pct();
-  if ( ref_sim2 ) stat_progress += divisor * ref_sim2 -> progress().pct();
+  // Every stat runs a delta and a reference sim, each adds its share of the progress of the stat
+  if ( ref_sim  ) stat_progress += ref_sim  -> progress().pct() / divisor;
+  if ( ref_sim2 ) stat_progress += ref_sim2 -> progress().pct() / divisor;
 
-  if ( delta_sim  ) stat_progress += divisor * delta_sim  -> progress().pct();
-  if ( delta_sim2 ) stat_progress += divisor * delta_sim2 -> progress().pct();
+  if ( delta_sim  ) stat_progress += delta_sim  -> progress().pct() / divisor;
+  if ( delta_sim2 ) stat_progress += delta_sim2 -> progress().pct() / divisor;
+
+  for ( auto* active_sim : active_sims )
+  {
+    stat_progress += active_sim -> progress().pct() / divisor;
+  }
 
   return stat_progress;
 }
@@ -241,116 +251,299 @@ void scale_factor_control_t::analyze_stats()
   baseline_sim = sim; // Take the current sim as baseline
   mutex.unlock();
 
-  for ( const auto& stat : stats_to_scale )
+  if ( concurrent_stats() )
+  {
+#ifndef SC_NO_THREADING
+    analyze_stats_parallel( stats_to_scale );
+#endif
+  }
+  else
   {
-    if ( sim -> is_canceled() ) break;
+    for ( const auto& stat : stats_to_scale )
+    {
+      if ( sim -> is_canceled() ) break;
 
-    current_scaling_stat = stat; // Stat we're scaling over
+      current_scaling_stat = stat; // Stat we're scaling over
 
-    double scale_delta = stats->get_stat( stat );
-    assert ( scale_delta );
+      double scale_delta = stats->get_stat( stat );
+      assert ( scale_delta );
 
-    bool center = center_scale_delta && ! stat_may_cap( stat );
+      bool center = center_scale_delta && ! stat_may_cap( stat );
 
-    mutex.lock();
-    ref_sim = baseline_sim;
-    delta_sim = new sim_t( sim );
-    mutex.unlock();
+      mutex.lock();
+      ref_sim = baseline_sim;
+      delta_sim = create_sim( stat, +scale_delta / ( center ? 2 : 1 ), util::stat_type_abbrev( stat ) );
+      mutex.unlock();
 
-    delta_sim -> progress_bar.set_base( util::stat_type_abbrev( stat ) );
+      delta_sim -> execute();
 
-    delta_sim -> scaling -> scale_stat = stat;
-    delta_sim -> scaling -> scale_value = +scale_delta / ( center ? 2 : 1 );
-    delta_sim -> execute();
+      if ( center )
+      {
+        mutex.lock();
+        ref_sim = create_sim( stat, -( scale_delta / 2 ), std::string( "Ref " ) + util::stat_type_abbrev( stat ) );
+        mutex.unlock();
+
+        ref_sim -> execute();
+      }
+
+      analyze_stat( stat, center, ref_sim, delta_sim );
 
-    if ( center )
-    {
       mutex.lock();
-      ref_sim = new sim_t( sim );
+      if ( ref_sim != baseline_sim && ref_sim != sim )
+      {
+        delete ref_sim;
+        ref_sim = nullptr;
+      }
+      delete delta_sim;
+      delta_sim  = nullptr;
+      remaining_scaling_stats--;
       mutex.unlock();
+    }
+  }
 
-      ref_sim -> progress_bar.set_base( std::string( "Ref " ) + util::stat_type_abbrev( stat ) );
+  if ( baseline_sim != sim ) delete baseline_sim;
+  baseline_sim = nullptr;
+}
 
-      ref_sim -> scaling -> scale_stat = stat;
-      ref_sim -> scaling -> scale_value = center ? -( scale_delta / 2 ) : 0;
-      ref_sim -> execute();
-    }
+// scaling_t::concurrent_stats ==============================================
 
-    for ( auto* p : sim->players_by_name )
-    {
-       if ( ! p -> scaling -> scales_with[ stat ] ) continue;
+// Stats are simulated concurrently when the threads can be split between at least two stat sims,
+// and there is more than one stat to simulate
+bool scale_factor_control_t::concurrent_stats() const
+{
+#ifndef SC_NO_THREADING
+  return work_threads > 0 && sim -> threads / work_threads > 1 && num_scaling_stats > 1;
+#else
+  return false;
+#endif
+}
 
-      player_t*   ref_p =   ref_sim -> find_player( p -> name() );
-      player_t* delta_p = delta_sim -> find_player( p -> name() );
-      assert( ref_p && "Reference Player not found" );
-      assert( delta_p && "Delta player not found" );
+// scaling_t::create_sim ====================================================
 
-      double divisor = scale_delta;
+sim_t* scale_factor_control_t::create_sim( stat_e stat, double value, const std::string& base )
+{
+  auto scale_sim = new sim_t( sim );
 
-      if ( delta_p -> invert_scaling )
-        divisor = -divisor;
+  scale_sim -> progress_bar.set_base( base );
 
-      if ( divisor < 0.0 ) divisor += ref_p -> scaling -> over_cap[ stat ];
+  scale_sim -> scaling -> scale_stat = stat;
+  scale_sim -> scaling -> scale_value = value;
 
-      for ( scale_metric_e sm = SCALE_METRIC_NONE; sm < SCALE_METRIC_MAX; sm++ )
-      {
+  // Concurrent stat sims split the threads between them, and report progress through the parent
+  if ( concurrent_stats() )
+  {
+    scale_sim -> threads = work_threads;
+    scale_sim -> report_progress = false;
+  }
+
+  return scale_sim;
+}
+
+// scaling_t::analyze_stat ==================================================
 
-        double delta_score = delta_p -> scaling_for_metric( sm ).value;
-        double   ref_score = ref_p -> scaling_for_metric( sm ).value;
+void scale_factor_control_t::analyze_stat( stat_e stat, bool center, sim_t* ref, sim_t* delta )
+{
+  double scale_delta = stats->get_stat( stat );
+
+  for ( auto* p : sim->players_by_name )
+  {
+     if ( ! p -> scaling -> scales_with[ stat ] ) continue;
 
-        double delta_error = delta_p -> scaling_for_metric( sm ).stddev * delta_sim -> confidence_estimator;
-        double   ref_error = ref_p -> scaling_for_metric( sm ).stddev * ref_sim -> confidence_estimator;
+    player_t*   ref_p =   ref -> find_player( p -> name() );
+    player_t* delta_p = delta -> find_player( p -> name() );
+    assert( ref_p && "Reference Player not found" );
+    assert( delta_p && "Delta player not found" );
 
-        double score = ( delta_score - ref_score ) / divisor;
-        double error = delta_error * delta_error + ref_error * ref_error;
+    double divisor = scale_delta;
 
-        if ( error > 0 )
-          error = sqrt( error );
+    if ( delta_p -> invert_scaling )
+      divisor = -divisor;
+
+    if ( divisor < 0.0 ) divisor += ref_p -> scaling -> over_cap[ stat ];
+
+    for ( scale_metric_e sm = SCALE_METRIC_NONE; sm < SCALE_METRIC_MAX; sm++ )
+    {
+
+      double delta_score = delta_p -> scaling_for_metric( sm ).value;
+      double   ref_score = ref_p -> scaling_for_metric( sm ).value;
 
-        error = fabs( error / divisor );
+      double delta_error = delta_p -> scaling_for_metric( sm ).stddev * delta -> confidence_estimator;
+      double   ref_error = ref_p -> scaling_for_metric( sm ).stddev * ref -> confidence_estimator;
 
-        if ( fabs( divisor ) < 1.0 ) // For things like Weapon Speed, show the gain per 0.1 speed gain rather than every 1.0.
+      double score = ( delta_score - ref_score ) / divisor;
+      double error = delta_error * delta_error + ref_error * ref_error;
+
+      if ( error > 0 )
+        error = sqrt( error );
+
+      error = fabs( error / divisor );
+
+      // Common random numbers pair each delta iteration with the reference iteration that used
+      // the same random numbers, the error of the paired difference is usually much smaller
+      double variance_reduction = 0;
+      if ( sim -> common_rng )
+      {
+        auto delta_data = delta_p -> collected_data.metric_sample_data( sm );
+        auto ref_data = ref_p -> collected_data.metric_sample_data( sm );
+        if ( delta_data && ref_data )
         {
-          score /= 10.0;
-          error /= 10.0;
-          delta_error /= 10.0;
+          auto paired = statistics::paired_difference( ref_p -> collected_data.iteration_keys, ref_data -> data(),
+                                                       delta_p -> collected_data.iteration_keys, delta_data -> data() );
+          if ( paired.count > 0 )
+          {
+            error = fabs( paired.mean_std_dev * sim -> confidence_estimator / divisor );
+            variance_reduction = paired.variance_reduction;
+          }
         }
+      }
 
-        analyze_ability_stats( stat, divisor, p, ref_p, delta_p );
+      if ( fabs( divisor ) < 1.0 ) // For things like Weapon Speed, show the gain per 0.1 speed gain rather than every 1.0.
+      {
+        score /= 10.0;
+        error /= 10.0;
+        delta_error /= 10.0;
+      }
 
-        if ( center )
-          p -> scaling -> scaling_compare_error[ sm ].set_stat( stat, error );
-        else
-          p -> scaling -> scaling_compare_error[ sm ].set_stat( stat, delta_error / divisor );
+      analyze_ability_stats( stat, divisor, p, ref_p, delta_p );
 
-        p -> scaling -> scaling[ sm ].set_stat( stat, score );
-        p -> scaling -> scaling_error[ sm ].set_stat( stat, error );
-      }
-    }
+      if ( center )
+        p -> scaling -> scaling_compare_error[ sm ].set_stat( stat, error );
+      else
+        p -> scaling -> scaling_compare_error[ sm ].set_stat( stat, delta_error / divisor );
 
-    if ( debug_scale_factors )
-    {
-      fmt::print( "\nref_sim report for '{}'...\n", util::stat_type_string( stat ) );
-      report::print_text( ref_sim, true );
-      fmt::print( "\ndelta_sim report for '{}'...\n", util::stat_type_string( stat ) );
-      report::print_text( delta_sim, true );
+      p -> scaling -> scaling[ sm ].set_stat( stat, score );
+      p -> scaling -> scaling_error[ sm ].set_stat( stat, error );
+      p -> scaling -> scaling_variance_reduction[ sm ].set_stat( stat, variance_reduction );
     }
+  }
 
-    mutex.lock();
-    if ( ref_sim != baseline_sim && ref_sim != sim )
+  if ( debug_scale_factors )
+  {
+    fmt::print( "\nref_sim report for '{}'...\n", util::stat_type_string( stat ) );
+    report::print_text( ref, true );
+    fmt::print( "\ndelta_sim report for '{}'...\n", util::stat_type_string( stat ) );
+    report::print_text( delta, true );
+  }
+}
+
+#ifndef SC_NO_THREADING
+// scaling_t::analyze_stats_parallel ========================================
+
+/* Simulates the stats on sim->threads / work_threads workers, each running the delta (and
+ * reference) sims of one stat at a time with work_threads threads. Results of a stat are
+ * analyzed as soon as its sims finish.
+ */
+void scale_factor_control_t::analyze_stats_parallel( const std::vector<stat_e>& stats_to_scale )
+{
+  size_t n_workers = std::min( as<size_t>( sim -> threads / work_threads ), stats_to_scale.size() );
+  std::atomic<size_t> next_stat( 0 );
+
+  mutex.lock();
+  current_scaling_stat = stats_to_scale.front();
+  mutex.unlock();
+
+  auto worker = [ this, &stats_to_scale, &next_stat ]() {
+    while ( ! sim -> is_canceled() )
     {
-      delete ref_sim;
-      ref_sim = nullptr;
+      size_t idx = next_stat++;
+      if ( idx >= stats_to_scale.size() )
+      {
+        break;
+      }
+
+      stat_e stat = stats_to_scale[ idx ];
+      double scale_delta = stats->get_stat( stat );
+      assert( scale_delta );
+
+      bool center = center_scale_delta && ! stat_may_cap( stat );
+
+      mutex.lock();
+      sim_t* delta = create_sim( stat, +scale_delta / ( center ? 2 : 1 ), util::stat_type_abbrev( stat ) );
+      sim_t* ref = center ? create_sim( stat, -( scale_delta / 2 ), std::string( "Ref " ) + util::stat_type_abbrev( stat ) )
+                          : baseline_sim;
+      active_sims.push_back( delta );
+      if ( ref != baseline_sim )
+      {
+        active_sims.push_back( ref );
+      }
+      mutex.unlock();
+
+      delta -> execute();
+      if ( ref != baseline_sim )
+      {
+        ref -> execute();
+      }
+
+      mutex.lock();
+      if ( ! sim -> is_canceled() )
+      {
+        analyze_stat( stat, center, ref, delta );
+      }
+
+      active_sims.erase( std::remove_if( active_sims.begin(), active_sims.end(), [ ref, delta ]( const sim_t* s ) {
+        return s == ref || s == delta;
+      } ), active_sims.end() );
+      if ( ref != baseline_sim )
+      {
+        delete ref;
+      }
+      delete delta;
+      remaining_scaling_stats--;
+      mutex.unlock();
+
+      if ( sim -> report_progress )
+      {
+        output_progressbar();
+      }
     }
-    delete delta_sim;  
-    delta_sim  = nullptr;
-    remaining_scaling_stats--;
-    mutex.unlock();
+  };
+
+  std::vector<std::thread> workers;
+  for ( size_t i = 0; i < n_workers; ++i )
+  {
+    workers.emplace_back( worker );
   }
 
-  if ( baseline_sim != sim ) delete baseline_sim;
-  baseline_sim = nullptr;
+  for ( auto& thread : workers )
+  {
+    thread.join();
+  }
+
+  if ( sim -> report_progress )
+  {
+    fmt::print( "\n" );
+  }
+}
+
+// scaling_t::output_progressbar ============================================
+
+void scale_factor_control_t::output_progressbar()
+{
+  AUTO_LOCK( mutex );
+
+  int done = num_scaling_stats - remaining_scaling_stats;
+  double pct = done / as<double>( num_scaling_stats );
+
+  std::string status = "[";
+  status.insert( 1, sim -> progress_bar.steps, '.' );
+  status += "]";
+
+  int length = as<int>( std::lround( sim -> progress_bar.steps * pct ) );
+  for ( int i = 1; i < length + 1; ++i )
+  {
+    status[ i ] = '=';
+  }
+
+  if ( length > 0 )
+  {
+    status[ length ] = '>';
+  }
+
+  fmt::print( "Scale Factors ({}*{}): {}/{} {}     \r", std::min( sim -> threads / work_threads, num_scaling_stats ),
+              work_threads, done, num_scaling_stats, status );
+  std::fflush( stdout );
 }
+#endif
 
 /* Creates scale factors for stats_t objects
  *
@@ -513,6 +706,7 @@ void scale_factor_control_t::create_options()
   sim->add_option(opt_bool("calculate_scale_factors", calculate_scale_factors));
   sim->add_option(opt_func("normalize_scale_factors", parse_normalize_scale_factors));
   sim->add_option(opt_bool("debug_scale_factors", debug_scale_factors));
+  sim->add_option(opt_int("scale_factor_work_threads", work_threads));
   sim->add_option(opt_bool("center_scale_delta", center_scale_delta));
   sim->add_option(opt_float("scale_delta_multiplier", scale_delta_multiplier)); // multiplies all default scale deltas
   sim->add_option(opt_bool("positive_scale_delta", positive_scale_delta));
@@ -10,6 +10,7 @@
 #include "util/concurrency.hpp"
 #include <string>
 #include <memory>
+#include <vector>
 
 struct gear_stats_t;
 struct player_t;
@@ -34,12 +35,16 @@ struct scale_factor_control_t
   double scale_factor_noise;
   int    normalize_scale_factors;
   int    debug_scale_factors;
+  // Threads of each concurrently simulated stat, 0 simulates one stat at a time with all threads
+  int    work_threads;
   std::string scale_only_str;
   stat_e current_scaling_stat;
   int num_scaling_stats, remaining_scaling_stats;
   std::string scale_over;
   scale_metric_e scaling_metric;
   std::string scale_over_player;
+  // Sims of concurrently simulated stats
+  std::vector<sim_t*> active_sims;
 
   // Gear delta for determining scale factors
   std::unique_ptr<gear_stats_t> stats;
@@ -49,6 +54,11 @@ struct scale_factor_control_t
   void init_deltas();
   void analyze();
   void analyze_stats();
+  void analyze_stats_parallel( const std::vector<stat_e>& );
+  void analyze_stat( stat_e, bool center, sim_t* ref, sim_t* delta );
+  sim_t* create_sim( stat_e, double value, const std::string& base );
+  bool concurrent_stats() const;
+  void output_progressbar();
   void analyze_ability_stats( stat_e, double, player_t*, player_t*, player_t* );
   void analyze_lag();
   void normalize();
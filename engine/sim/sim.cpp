@@ -15,11 +15,13 @@
 #include "player/pet.hpp"
 #include "player/player.hpp"
 #include "player/spawner_base.hpp"
+#include "player/stats.hpp"
 #include "player/unique_gear.hpp"
 #include "report/json/report_configuration.hpp"
 #include "report/reports.hpp"
 #include "report/highchart.hpp"
 #include "profileset.hpp"
+#include "sim/engine_profiler.hpp"
 #include "sim/event.hpp"
 #include "sim/iteration_data_entry.hpp"
 #include "sim/plot.hpp"
@@ -31,6 +33,7 @@
 #include "sim/profileset.hpp"
 #include "sim/scale_factor_control.hpp"
 #include "sim/sim_control.hpp"
+#include "sim/snapshot.hpp"
 #include "sim/work_queue.hpp"
 #include "util/string_view.hpp"
 #include "util/xml.hpp"
@@ -39,12 +42,17 @@
 #include <iostream>
 #include <random>
 #include <sstream>
+#include <unordered_map>
 #ifdef SC_WINDOWS
 #include <direct.h>
 #endif
 
 namespace { // UNNAMED NAMESPACE ============================================
 
+// Chart data buffer of the HTML report section rendered by this thread, see
+// sim_t::buffer_chart_data()
+thread_local sim_t::chart_data_buffer_t* thread_chart_data_buffer = nullptr;
+
 // Comparator for iteration data entry sorting (see analyze_iteration_data)
 bool iteration_data_cmp( const iteration_data_entry_t& a,
                          const iteration_data_entry_t& b )
@@ -136,6 +144,8 @@ bool parse_debug_seed( sim_t* sim, util::string_view, util::string_view value )
  * - full_states [bool]: Collects and reports full action and other states, greatly increasing the report size.
  * - pretty_print [bool]: Pretty-print (whitespaces and indentation) the report.
  * - decimal_places [int]: limit floating point decimal places. Valid if > 0
+ * - document [bool]: Build the whole report in memory before writing it, as the report was written before it
+ *   was streamed. The output is identical, used to test the streamed report.
  */
 bool parse_json_reports( sim_t* sim, util::string_view /* option_name */, util::string_view value )
 {
@@ -150,6 +160,7 @@ bool parse_json_reports( sim_t* sim, util::string_view /* option_name */, util::
   std::string report_version;
   bool fullStates = false;
   bool pretty_print = false;
+  bool single_document = false;
   int decimal_places = 0;
   if ( splits.size() > 1 )
   {
@@ -193,6 +204,17 @@ bool parse_json_reports( sim_t* sim, util::string_view /* option_name */, util::
           std::throw_with_nested( std::runtime_error( "Canot parse JSON report option 'pretty_print'" ) );
         }
       }
+      if ( splitOptions[ 0 ] == "document" )
+      {
+        try
+        {
+          single_document = util::to_int( splitOptions[ 1 ] );
+        }
+        catch ( const std::exception& )
+        {
+          std::throw_with_nested( std::runtime_error( "Canot parse JSON report option 'document'" ) );
+        }
+      }
       if ( splitOptions[ 0 ] == "decimal_places" )
       {
         // limit floating point decimal places. Valid if > 0
@@ -212,6 +234,7 @@ bool parse_json_reports( sim_t* sim, util::string_view /* option_name */, util::
   entry.full_states = fullStates;
   entry.decimal_places = decimal_places;
   entry.pretty_print = pretty_print;
+  entry.single_document = single_document;
 
   sim->json_reports.push_back( std::move( entry ) );
 
@@ -718,6 +741,24 @@ bool parse_fight_style( sim_t*             sim,
   return true;
 }
 
+// parse_event_queue ========================================================
+
+bool parse_event_queue( sim_t*             sim,
+                        util::string_view /* name */,
+                        util::string_view value )
+{
+  if ( util::str_compare_ci( value, "wheel" ) )
+    sim->event_mgr.queue_type = EVENT_QUEUE_WHEEL;
+  else if ( util::str_compare_ci( value, "hierarchical" ) )
+    sim->event_mgr.queue_type = EVENT_QUEUE_HIERARCHICAL;
+  else if ( util::str_compare_ci( value, "heap" ) )
+    sim->event_mgr.queue_type = EVENT_QUEUE_HEAP;
+  else
+    throw std::invalid_argument( fmt::format( "Invalid event queue '{}', valid values are wheel, hierarchical and heap.", value ) );
+
+  return true;
+}
+
 // parse_override_spell_data ================================================
 
 bool parse_override_spell_data( sim_t*             sim,
@@ -1410,7 +1451,6 @@ struct compare_name
 // sims progress with the main thread's current index.
 sim_progress_t work_queue_t::progress( int idx )
 {
-  G l(m);
   size_t current_index = idx;
   if ( idx < 0 )
   {
@@ -1493,6 +1533,15 @@ sim_t::sim_t()
     ignite_sampling_delta( 200_ms ),
     optimize_expressions( 2 ),
     optimize_expressions_rounds( 1 ),
+    shared_aoe_snapshot( 0 ),
+    apl_expression_compiler( 0 ),
+    apl_expression_stats(),
+    apl_readiness_cache( 0 ),
+    apl_readiness_stats(),
+    profile_engine( 0 ),
+    engine_profiler(),
+    buff_effects_cache( 0 ),
+    buff_stack_generation( 0 ),
     current_slot( -1 ),
     optimal_raid( 0 ),
     log( 0 ),
@@ -1545,6 +1594,8 @@ sim_t::sim_t()
     seed( 0 ),
     deterministic( 0 ),
     strict_work_queue( 0 ),
+    common_rng( 0 ),
+    iteration_key( 0 ),
     average_range( true ),
     average_gauss( false ),
     fight_style(),
@@ -1591,6 +1642,7 @@ sim_t::sim_t()
     save_raid_summary( 0 ),
     save_gear_comments( 0 ),
     statistics_level( 1 ),
+    streaming_sample_data( false ),
     separate_stats_by_actions( 0 ),
     report_raid_summary( 0 ),
     buff_uptime_timeline( 1 ),
@@ -1615,6 +1667,18 @@ sim_t::sim_t()
     thread_index( 0 ),
     process_priority( computer_process::BELOW_NORMAL ),
     work_queue( new work_queue_t() ),
+    work_chunk(),
+    child_setup(),
+    child_control(),
+    merge_tree( true ),
+    merge_ready( false ),
+    merged_sims(),
+    merge_level_time(),
+    analyze_buff_time(),
+    analyze_stats_time(),
+    analyze_actor_time(),
+    execute_start(),
+    startup_time(),
     spell_query(),
     spell_query_level( MAX_LEVEL ),
     pause_mutex( nullptr ),
@@ -1634,6 +1698,10 @@ sim_t::sim_t()
     profileset_enabled( false ),
     profileset_work_threads( 0 ),
     profileset_init_threads( 1 ),
+    profileset_reuse_init( true ),
+    profileset_race_iterations( 0 ),
+    profileset_race_rounds( 3 ),
+    profileset_race_top( 10 ),
     profilesets( std::make_unique<profileset::profilesets_t>() )
 {
   item_db_sources.assign( std::begin( default_item_db_sources ), std::end( default_item_db_sources ) );
@@ -1681,6 +1749,10 @@ sim_t::sim_t( sim_t* p, int index, sim_control_t* control ) : sim_t()
   parent = p;
   thread_index = index;
 
+  // Register before setup, so that a sim failing setup (e.g., profileset validation) can be
+  // destroyed normally
+  parent -> add_relative( this );
+
   // Use specialized control for setup
   setup( control );
 
@@ -1697,6 +1769,17 @@ sim_t::sim_t( sim_t* p, int index, sim_control_t* control ) : sim_t()
 
   // While we inherit the parent seed, it may get overwritten in sim_t::init
   seed = parent -> seed;
+}
+
+sim_t::sim_t( sim_t* p, int index, std::unique_ptr<child_setup_t> setup ) : sim_t()
+{
+  assert( p && setup );
+
+  parent = p;
+  thread_index = index;
+
+  // Setup is done in the child's own thread, see sim_t::setup_child()
+  child_setup = std::move( setup );
 
   parent -> add_relative( this );
 }
@@ -1855,7 +1938,22 @@ void sim_t::reset()
 {
   print_debug( "Resetting Simulator" );
 
-  if( deterministic )
+  if ( common_rng )
+  {
+    // Threads with their own work queue interleave their keys
+    if ( deterministic || strict_work_queue )
+    {
+      iteration_key = as<uint64_t>( thread_index ) + as<uint64_t>( threads ) * as<uint64_t>( current_iteration );
+    }
+    else
+    {
+      iteration_key = work_queue -> claim_key();
+    }
+
+    _rng.seed( seed + iteration_key );
+    _rng.reset();
+  }
+  else if( deterministic )
     seed = rng().reseed();
 
   event_mgr.reset();
@@ -2136,9 +2234,12 @@ void sim_t::datacollection_end()
   if ( deterministic && report_iteration_data > 0 && current_iteration > 0 &&
        current_time() > timespan_t::zero() )
   {
+    // With common random numbers, the iteration is seeded from its key
+    uint64_t iteration_seed = common_rng ? seed + iteration_key : seed;
+
     // TODO: Metric should be selectable
     iteration_data_entry_t entry( iteration_dmg / current_time().total_seconds(),
-        current_time().total_seconds(), seed, current_iteration );
+        current_time().total_seconds(), iteration_seed, current_iteration );
     for ( auto* t : target_list )
     {
        // Once we start hitting adds (instead of real enemies), break out as those don't have real
@@ -2152,10 +2253,10 @@ void sim_t::datacollection_end()
     }
 
     if ( std::find_if( iteration_data.begin(), iteration_data.end(),
-                       seed_predicate_t( seed ) ) != iteration_data.end() )
+                       seed_predicate_t( iteration_seed ) ) != iteration_data.end() )
     {
       errorf( "[Thread-%d] Duplicate seed %llu found on iteration %u, skipping ...",
-          thread_index, seed, current_iteration );
+          thread_index, iteration_seed, current_iteration );
     }
     else
     {
@@ -2697,6 +2798,15 @@ void sim_t::init()
 
   event_mgr.init();
 
+  if ( profile_engine )
+  {
+#ifdef ENGINE_PROFILER
+    engine_profiler = std::make_unique<engine_profiler_t>();
+#else
+    error( "profile_engine=1 needs a build with the engine profiler ( SC_ENGINE_PROFILER cmake option ), ignoring." );
+#endif
+  }
+
   unique_gear::register_target_data_initializers( this );
 
   // Seed RNG
@@ -2960,8 +3070,51 @@ void sim_t::analyze()
 
   raid_dps.analyze();
 
-  for ( size_t i = 0; i < buff_list.size(); ++i )
-    buff_list[ i ] -> analyze();
+  for ( auto* actor : actor_list )
+    actor -> pre_analyze_hook();
+
+  // The buff, stats and actor phases are spread over the thread budget of the simulation. Every
+  // phase is finished before the next one starts, and analyzes objects that are independent of
+  // each other within the phase, so the results do not depend on the number of threads.
+
+  // Sim-wide buffs only depend on the simulation length
+  auto phase_start = chrono::wall_clock::now();
+  thread::parallel_for_each( buff_list, threads, []( buff_t* b ) { b -> analyze(); } );
+  analyze_buff_time = chrono::elapsed( phase_start );
+
+  // Action stats of reported actors, including their pets ( see player_t::analyze ). Child stats
+  // are analyzed by their parent, player_t::analyze skips stats that are already analyzed.
+  phase_start = chrono::wall_clock::now();
+
+  // Like player_t::analyze, skip actors without collected data whose pets have none either. The
+  // fight length mean is analyzed again with the rest of the collected data.
+  for ( auto* actor : actor_list )
+    actor -> collected_data.fight_length.analyze_basics();
+
+  auto has_data = []( const player_t* p ) {
+    if ( p -> collected_data.fight_length.mean() != 0 )
+      return true;
+
+    return range::any_of( p -> pet_list, []( const pet_t* pet ) {
+      return pet -> collected_data.fight_length.mean() > 0 || pet -> iteration_fight_length.total_seconds() > 0;
+    } );
+  };
+
+  std::vector<stats_t*> stats;
+  for ( auto* actor : actor_list )
+  {
+    if ( actor -> quiet || actor -> is_pet() || !has_data( actor ) )
+      continue;
+
+    auto add_stats = [ &stats ]( const player_t* p ) {
+      range::copy_if( p -> stats_list, std::back_inserter( stats ), []( const stats_t* s ) { return !s -> parent; } );
+    };
+
+    add_stats( actor );
+    range::for_each( actor -> pet_list, add_stats );
+  }
+  thread::parallel_for_each( stats, threads, []( stats_t* s ) { s -> analyze(); } );
+  analyze_stats_time = chrono::elapsed( phase_start );
 
   if ( scaling -> scale_stat == STAT_NONE &&
        scaling -> calculate_scale_factors == 0 &&
@@ -2973,8 +3126,40 @@ void sim_t::analyze()
     std::fflush( stdout );
   }
 
-  for ( size_t i = 0; i < actor_list.size(); i++ )
-    actor_list[ i ] -> analyze( *this );
+  // Pets are analyzed after their owner, on the same thread, since the analysis of an actor reads
+  // and adjusts the data of its pets
+  phase_start = chrono::wall_clock::now();
+  std::vector<std::vector<player_t*>> actor_groups;
+  std::unordered_map<const player_t*, size_t> group_index;
+  for ( auto* actor : actor_list )
+  {
+    const player_t* owner = actor;
+    while ( owner -> is_pet() && owner -> cast_pet() -> owner )
+      owner = owner -> cast_pet() -> owner;
+
+    auto it = group_index.find( owner );
+    if ( it == group_index.end() )
+    {
+      it = group_index.emplace( owner, actor_groups.size() ).first;
+      actor_groups.emplace_back();
+    }
+
+    actor_groups[ it -> second ].push_back( actor );
+  }
+
+  thread::parallel_for_each( actor_groups, threads, [ this ]( const std::vector<player_t*>& group ) {
+    range::for_each( group, [ this ]( player_t* p ) { p -> analyze( *this ); } );
+  } );
+  analyze_actor_time = chrono::elapsed( phase_start );
+
+  // Restore the actor order the lists would have if the actors were analyzed sequentially
+  auto by_actor_index = []( const player_t* l, const player_t* r ) { return l -> actor_index < r -> actor_index; };
+  for ( auto* list : { &players_by_dps, &players_by_priority_dps, &players_by_hps, &players_by_hps_plus_aps,
+                       &players_by_dtps, &players_by_tmi, &players_by_name, &players_by_apm, &players_by_variance,
+                       &targets_by_name } )
+  {
+    range::sort( *list, by_actor_index );
+  }
 
   range::sort( players_by_dps,  compare_dps() );
   range::sort( players_by_priority_dps, compare_priority_dps() );
@@ -3040,6 +3225,8 @@ bool sim_t::iterate()
     return false;
   }
 
+  startup_time = chrono::elapsed( execute_start );
+
   progress_bar.init();
 
   activate_actors();
@@ -3061,8 +3248,8 @@ bool sim_t::iterate()
     auto old_active = current_index;
     if ( ! canceled )
     {
-      current_index = work_queue -> pop();
-      more_work = work_queue -> more_work();
+      current_index = work_queue -> pop( work_chunk );
+      more_work = work_queue -> more_work( work_chunk );
 
       if ( more_work && current_index != old_active )
       {
@@ -3133,9 +3320,16 @@ void sim_t::set_error(std::string error)
     fmt::print( stderr, "{}\n", error );
     std::fflush( stderr );
 
+    AUTO_LOCK( error_mutex );
     error_list.push_back( std::move( error ) );
 }
 
+std::vector<std::string> sim_t::errors() const
+{
+  AUTO_LOCK( error_mutex );
+  return error_list;
+}
+
 /// merge sims
 void sim_t::merge( sim_t& other_sim )
 {
@@ -3153,7 +3347,25 @@ void sim_t::merge( sim_t& other_sim )
   }
 
   iterations += other_sim.iterations;
-  work_per_thread[ other_sim.thread_index ] = other_sim.work_done;
+  for ( size_t i = 0; i < work_per_thread.size() && i < other_sim.work_per_thread.size(); ++i )
+  {
+    work_per_thread[ i ] += other_sim.work_per_thread[ i ];
+  }
+  startup_time = std::max( startup_time, other_sim.startup_time );
+  apl_expression_stats.merge( other_sim.apl_expression_stats );
+  apl_readiness_stats.merge( other_sim.apl_readiness_stats );
+  if ( engine_profiler && other_sim.engine_profiler )
+  {
+    engine_profiler->merge( *other_sim.engine_profiler );
+  }
+  if ( merge_level_time.size() < other_sim.merge_level_time.size() )
+  {
+    merge_level_time.resize( other_sim.merge_level_time.size() );
+  }
+  for ( size_t i = 0; i < other_sim.merge_level_time.size(); ++i )
+  {
+    merge_level_time[ i ] = std::max( merge_level_time[ i ], other_sim.merge_level_time[ i ] );
+  }
 
   simulation_length.merge( other_sim.simulation_length );
   total_dmg.merge( other_sim.total_dmg );
@@ -3185,13 +3397,11 @@ void sim_t::merge( sim_t& other_sim )
     player -> merge( *other_p );
   }
 
-  // After normal player merging, merge all dynamically spawned players. This is done after the
-  // normal player merging because the dynamic spawner merging process may need to create new actors
-  // into the parent (e.g., thread 0) sim to accommodate child sims managing to create more actors
-  // than the parent
-  spawner::merge( *this, other_sim );
+  // Dynamically spawned players are merged by thread 0 once all threads are merged, see
+  // sim_t::merge()
 
   range::append( iteration_data, other_sim.iteration_data );
+  range::append( merged_sims, other_sim.merged_sims );
   merge_time += chrono::elapsed(start_time);
 }
 
@@ -3205,33 +3415,133 @@ void sim_t::merge()
 
   merge_mutex.unlock();
 
-  for ( auto& child : children )
+  // Thread 0 is the root of the merge tree, even if its own simulation failed
+  merge_subtree( true );
+
+  // After normal player merging, merge all dynamically spawned players. This is done after the
+  // normal player merging because the dynamic spawner merging process may need to create new actors
+  // into the parent (e.g., thread 0) sim to accommodate child sims managing to create more actors
+  // than the parent
+  for ( sim_t* other_sim : merged_sims )
+  {
+    if ( other_sim != this )
+    {
+      spawner::merge( *this, *other_sim );
+    }
+  }
+
+  if ( requires_cleanup() )
   {
-    if ( child )
+    for ( auto& child : children )
     {
-      child -> join();
-      sim_t* copy = child;
-      child = nullptr;
-      if ( requires_cleanup() )
+      delete child;
+    }
+  }
+
+  children.clear();
+  merged_sims.clear();
+  child_control.reset();
+}
+
+// sim_t::merge_subtree =====================================================
+
+// Thread child sims are merged pairwise in a binomial tree: thread k merges threads k + 1, k + 2,
+// k + 4, ... up to (excluding) the lowest set bit of k, thread 0 merges threads 1, 2, 4, .... The
+// merges of a tree level run concurrently on different threads, each merge joins the thread it
+// merges, so every thread is joined exactly once. With merge_tree=0 thread 0 merges all threads in
+// thread order, like the serial merge. Sample data is kept in thread order either way, but sums are
+// added in tree order, so the tree merge is only equal to the serial merge up to floating point
+// rounding.
+void sim_t::merge_subtree( bool success )
+{
+  sim_t* root = thread_index == 0 ? this : parent;
+  int n_threads = as<int>( root -> children.size() ) + 1;
+
+  std::vector<std::pair<sim_t*, unsigned>> partners;
+  if ( ! root -> merge_tree )
+  {
+    if ( thread_index == 0 )
+    {
+      for ( auto child : children )
+        partners.emplace_back( child, 0 );
+    }
+  }
+  else
+  {
+    unsigned level = 0;
+    for ( int stride = 1; thread_index + stride < n_threads; stride *= 2, ++level )
+    {
+      if ( thread_index != 0 && ( thread_index & stride ) )
       {
-        delete copy;
+        break;
       }
+
+      partners.emplace_back( root -> children[ thread_index + stride - 1 ], level );
     }
   }
 
-  children.clear();
+  // Always join the whole subtree first, so no thread is left running if merging fails
+  for ( const auto& partner : partners )
+  {
+    partner.first -> join();
+  }
+
+  merged_sims.push_back( this );
+  merge_ready = success;
+  if ( ! success )
+  {
+    // The threads already merged into the partners are dropped with this one
+    size_t dropped = 0;
+    for ( const auto& partner : partners )
+    {
+      if ( partner.first -> merge_ready )
+        dropped += partner.first -> merged_sims.size();
+    }
+
+    root -> error( "Simulation thread {} failed, dropping its results and the results of {} merged threads.",
+                   thread_index, dropped );
+    return;
+  }
+
+  try
+  {
+    for ( const auto& partner : partners )
+    {
+      if ( ! partner.first -> merge_ready )
+      {
+        continue;
+      }
+
+      const auto start_time = chrono::wall_clock::now();
+      merge( *partner.first );
+      if ( merge_level_time.size() <= partner.second )
+      {
+        merge_level_time.resize( partner.second + 1 );
+      }
+      merge_level_time[ partner.second ] += chrono::elapsed( start_time );
+    }
+  }
+  catch ( const std::exception& e )
+  {
+    root -> error( "Error merging simulation thread {}: {}", thread_index, e.what() );
+    merge_ready = false;
+    cancel();
+  }
 }
 
 // sim_t::run ===============================================================
 
 void sim_t::run()
 {
+  bool success = false;
   try
   {
-    if( iterate() )
+    if ( child_setup )
     {
-      parent -> merge( *this );
+      setup_child();
     }
+
+    success = iterate();
   }
   catch (const std::exception& e )
   {
@@ -3239,6 +3549,14 @@ void sim_t::run()
       parent -> error("Error in child simulation ({}): {}", thread_index, e.what());
     cancel();
   }
+
+  // Record the work of this thread before it gets merged up the tree
+  if ( as<size_t>( thread_index ) < work_per_thread.size() )
+  {
+    work_per_thread[ thread_index ] = work_done;
+  }
+
+  merge_subtree( success );
 }
 
 // sim_t::partition =========================================================
@@ -3270,55 +3588,67 @@ void sim_t::partition()
 
   int num_children = threads - 1;
 
-  sim_control_t* child_control = nullptr;
   // Filter out profileset-related options from the child sim control, since they are not going to
   // use them anyhow. This significantly speeds up child creation in situations where the input
-  // profile is a very large set of profileset sims.
+  // profile is a very large set of profileset sims. The filtered control has to outlive the
+  // children, since they are set up in their own threads.
+  sim_control_t* setup_control = control;
   if ( !profileset_map.empty() )
   {
-    child_control = profileset::filter_control( control );
-  }
-  else
-  {
-    child_control = control;
+    child_control.reset( profileset::filter_control( control ) );
+    setup_control = child_control.get();
   }
 
   for ( int i = 0; i < num_children; i++ )
   {
-    auto  child = new sim_t( this, i + 1, child_control );
-
-    assert( child );
-    children.push_back( child );
-
-    child -> iterations = iterations;
+    // Everything the child inherits from the parent is captured here, before the parent starts
+    // initializing itself concurrently with the children
+    auto setup = std::make_unique<child_setup_t>();
+    setup -> control = setup_control;
+    setup -> iterations = iterations;
     if ( remainder )
     {
-      child -> iterations += 1;
+      setup -> iterations += 1;
       remainder--;
     }
+    setup -> scale_stat = scaling -> scale_stat;
+    setup -> scale_value = scaling -> scale_value;
+    setup -> enchant = enchant;
+    setup -> seed = seed;
+
+    auto child = new sim_t( this, i + 1, std::move( setup ) );
+    children.push_back( child );
+
+    child -> execute_start = execute_start;
 
     if( deterministic || strict_work_queue )
     {
-      child -> work_queue -> init( child -> iterations );
+      if ( single_actor_batch )
+      {
+        child -> work_queue -> batches( player_no_pet_list.size() );
+      }
+      child -> work_queue -> init( child -> child_setup -> iterations );
     }
     else // share the work queue
     {
       child -> work_queue = work_queue;
     }
-    child -> report_progress = 0;
   }
 
-  computer_process::set_priority( process_priority ); // Set main thread priority
-
-  for ( auto & child : children )
-    child -> launch();
-
-  // Safe to do for now, since control is only referenced by sim_t::setup, which is called in the
-  // sim_t constructor.
-  if ( !profileset_map.empty() )
+  if ( !deterministic && !strict_work_queue )
   {
-    delete child_control;
+    work_queue -> consumers( threads );
   }
+
+  computer_process::set_priority( process_priority ); // Set main thread priority
+
+  // The children set up and initialize themselves in their own threads while the parent
+  // initializes in iterate(). Static lookup tables filled on first use ( the name indices of
+  // dbc/name_index.hpp ) are function-local statics, whose initialization is thread-safe.
+  // Launch in reverse order, so that without threading support each merge tree partner has
+  // finished before the thread merging it runs
+  for ( auto it = children.rbegin(); it != children.rend(); ++it )
+    ( *it ) -> launch();
 }
 
 // sim_t::execute ===========================================================
@@ -3327,6 +3657,7 @@ bool sim_t::execute()
 {
   const auto start_cpu_time  = chrono::cpu_clock::now();
   const auto start_wall_time = chrono::wall_clock::now();
+  execute_start = start_wall_time;
 
   bool success = false;
   {
@@ -3335,6 +3666,19 @@ bool sim_t::execute()
     success = iterate();
   }
 
+  // The snapshot holds the merged, not yet analyzed results, so it can be merged with other runs
+  if ( success && parent == nullptr && !snapshot_file_str.empty() )
+  {
+    try
+    {
+      snapshot::save( *this, snapshot_file_str );
+    }
+    catch ( const std::exception& e )
+    {
+      error( "Error writing snapshot: {}", e.what() );
+    }
+  }
+
   if( success )
     analyze();
 
@@ -3344,6 +3688,52 @@ bool sim_t::execute()
   return success;
 }
 
+// sim_t::merge_snapshots ===================================================
+
+// Report the merged results of snapshots ( merge= ) instead of simulating. The sim is initialized
+// from the same profile the snapshots were simulated with, and collects no results of its own.
+void sim_t::merge_snapshots()
+{
+  const auto start_wall_time = chrono::wall_clock::now();
+
+  try
+  {
+    init();
+  }
+  catch ( const std::exception& )
+  {
+    std::throw_with_nested( std::runtime_error( "Initializing" ) );
+  }
+
+  iterations = 0;
+  // Snapshots simulated with the same seed hold the same iterations
+  std::vector<uint64_t> seeds;
+  for ( const auto& file : merge_snapshot_files )
+  {
+    fmt::print( "Merging snapshot '{}' ...\n", file );
+    std::fflush( stdout );
+
+    try
+    {
+      auto snapshot_seed = snapshot::merge( *this, file );
+      if ( range::contains( seeds, snapshot_seed ) )
+      {
+        throw std::runtime_error( fmt::format( "Snapshot was simulated with seed {} like a previous snapshot",
+                                               snapshot_seed ) );
+      }
+      seeds.push_back( snapshot_seed );
+    }
+    catch ( const std::exception& )
+    {
+      std::throw_with_nested( std::runtime_error( fmt::format( "Merging snapshot '{}'", file ) ) );
+    }
+  }
+
+  analyze();
+
+  elapsed_time = chrono::elapsed( start_wall_time );
+}
+
 /// find player in sim by name
 player_t* sim_t::find_player( util::string_view name ) const
 {
@@ -3627,6 +4017,7 @@ void sim_t::create_options()
   add_option( opt_float( "vary_combat_length", vary_combat_length, 0.0, 1.0 ) );
   add_option( opt_func( "ptr", parse_ptr ) );
   add_option( opt_int( "threads", threads ) );
+  add_option( opt_bool( "merge_tree", merge_tree ) );
   add_option( opt_float( "confidence", confidence, 0.0, 1.0 ) );
   add_option( opt_func( "spell_query", parse_spell_query ) );
   add_option( opt_string( "spell_query_xml_output_file", spell_query_xml_output_file_str ) );
@@ -3636,6 +4027,11 @@ void sim_t::create_options()
   add_option( opt_int( "max_aoe_enemies", max_aoe_enemies ) );
   add_option( opt_int( "optimize_expressions", optimize_expressions, 0, std::numeric_limits<int>::max() ) );
   add_option( opt_int( "optimize_expressions_rounds", optimize_expressions_rounds, 0, 100 ) );
+  add_option( opt_bool( "shared_aoe_snapshot", shared_aoe_snapshot ) );
+  add_option( opt_bool( "apl_expression_compiler", apl_expression_compiler ) );
+  add_option( opt_bool( "apl_readiness_cache", apl_readiness_cache ) );
+  add_option( opt_bool( "profile_engine", profile_engine ) );
+  add_option( opt_bool( "buff_effects_cache", buff_effects_cache ) );
   add_option( opt_bool( "single_actor_batch", single_actor_batch ) );
   add_option( opt_bool( "progressbar_type", progressbar_type ) );
   add_option( opt_bool( "allow_experimental_specializations", allow_experimental_specializations ) );
@@ -3686,6 +4082,12 @@ void sim_t::create_options()
   add_option( opt_func( "json", parse_json_reports ) );
   add_option( opt_func( "json2", replace_json2 ) );
   add_option( opt_string( "html", html_file_str ) );
+  add_option( opt_string( "results_binary", results_binary_file_str ) );
+  add_option( opt_string( "snapshot", snapshot_file_str ) );
+  add_option( opt_func( "merge", []( sim_t* sim, util::string_view, util::string_view value ) {
+    sim -> merge_snapshot_files = util::string_split<std::string>( value, "," );
+    return true;
+  } ) );
   add_option( opt_bool( "hosted_html", hosted_html ) );
   add_option( opt_int( "healing", healing ) );
   add_option( opt_bool( "log", log ) );
@@ -3710,6 +4112,7 @@ void sim_t::create_options()
   add_option( opt_obsoleted( "rng" ) );
   add_option( opt_bool( "deterministic", deterministic ) );
   add_option( opt_bool( "strict_work_queue", strict_work_queue ) );
+  add_option( opt_bool( "common_rng", common_rng ) );
   add_option( opt_float( "report_iteration_data", report_iteration_data ) );
   add_option( opt_int( "min_report_iteration_data", min_report_iteration_data ) );
   add_option( opt_bool( "average_range", average_range ) );
@@ -3720,7 +4123,10 @@ void sim_t::create_options()
   add_option( opt_uint64( "seed", seed ) );
   add_option( opt_float( "wheel_granularity", event_mgr.wheel_granularity ) );
   add_option( opt_int( "wheel_seconds", event_mgr.wheel_seconds ) );
-  add_option( opt_int( "wheel_shift", event_mgr.wheel_shift ) );
+  // The wheel covers at least 1024 seconds, up to 2^15 ms slices keep at least 32 slices, the fine
+  // wheel of the hierarchical queue ( see event_manager_t::init )
+  add_option( opt_int( "wheel_shift", event_mgr.wheel_shift, 0, 15 ) );
+  add_option( opt_func( "event_queue", parse_event_queue ) );
   add_option( opt_string( "reference_player", reference_player_str ) );
   add_option( opt_string( "raid_events", raid_events_str ) );
   add_option( opt_append( "raid_events+", raid_events_str ) );
@@ -3810,6 +4216,7 @@ void sim_t::create_options()
   add_option( opt_bool( "report_raw_abilities", report_raw_abilities ) );
   add_option( opt_bool( "report_rng", report_rng ) );
   add_option( opt_int( "statistics_level", statistics_level ) );
+  add_option( opt_bool( "streaming_sample_data", streaming_sample_data ) );
   add_option( opt_bool( "separate_stats_by_actions", separate_stats_by_actions ) );
   add_option( opt_bool( "report_raid_summary", report_raid_summary ) ); // Force reporting of raid summary
   add_option( opt_string( "reforge_plot_output_file", reforge_plot_output_file_str ) );
@@ -4248,15 +4655,16 @@ void sim_t::setup( sim_control_t* c )
     }
   }
 
-  if ( single_actor_batch )
+  // Thread child sims use the work queue prepared by the parent in sim_t::partition()
+  if ( ! child_setup )
   {
-    work_queue -> batches( player_no_pet_list.size() );
-  }
-  work_queue -> init( iterations );
-  if ( thread_index == 0 )
-  {
-    work_per_thread.resize( threads );
+    if ( single_actor_batch )
+    {
+      work_queue -> batches( player_no_pet_list.size() );
+    }
+    work_queue -> init( iterations );
   }
+  work_per_thread.resize( threads );
 
   if( deterministic && ( target_error != 0 ) )
   {
@@ -4264,6 +4672,25 @@ void sim_t::setup( sim_control_t* c )
   }
 }
 
+// sim_t::setup_child =======================================================
+
+void sim_t::setup_child()
+{
+  assert( parent && child_setup );
+
+  setup( child_setup -> control );
+
+  // Apply the settings inherited from the parent, these are set outside of the config file
+  scaling -> scale_stat  = child_setup -> scale_stat;
+  scaling -> scale_value = child_setup -> scale_value;
+  enchant = child_setup -> enchant;
+  seed = child_setup -> seed;
+  iterations = child_setup -> iterations;
+  report_progress = 0;
+
+  child_setup.reset();
+}
+
 // sim_t::progress ==========================================================
 
 sim_progress_t sim_t::progress( std::string* detailed, int index )
@@ -4366,7 +4793,18 @@ void sim_t::abort()
 /// add chart to sim for end of report processing
 void sim_t::add_chart_data( const highchart::chart_t& chart )
 {
-  if ( chart.toggle_id_str_.empty() )
+  if ( thread_chart_data_buffer )
+  {
+    if ( chart.toggle_id_str_.empty() )
+    {
+      thread_chart_data_buffer -> emplace_back( std::string(), chart.to_aggregate_string( false ) );
+    }
+    else
+    {
+      thread_chart_data_buffer -> emplace_back( chart.toggle_id_str_, chart.to_data() );
+    }
+  }
+  else if ( chart.toggle_id_str_.empty() )
   {
     on_ready_chart_data.push_back( chart.to_aggregate_string( false ) );
   }
@@ -4376,6 +4814,26 @@ void sim_t::add_chart_data( const highchart::chart_t& chart )
   }
 }
 
+void sim_t::add_chart_data( const chart_data_buffer_t& buffer )
+{
+  for ( const auto& entry : buffer )
+  {
+    if ( entry.first.empty() )
+    {
+      on_ready_chart_data.push_back( entry.second );
+    }
+    else
+    {
+      chart_data[ entry.first ].push_back( entry.second );
+    }
+  }
+}
+
+void sim_t::buffer_chart_data( chart_data_buffer_t* buffer )
+{
+  thread_chart_data_buffer = buffer;
+}
+
 void sim_t::print_spell_query()
 {
   if ( ! spell_query_xml_output_file_str.empty() )
@@ -4448,16 +4906,24 @@ std::vector<double> sc_timeline_t::build_divisor_timeline( const extended_sample
  */
 void sc_timeline_t::adjust( sim_t& sim )
 {
-  // Check if we have divisor timeline cached
-  auto it = sim.divisor_timeline_cache.find( bin_size_ );
-  if ( it == sim.divisor_timeline_cache.end() )
+  const std::vector<double>* divisor_timeline;
   {
-    // If we don't have a cached divisor timeline, build one
-    sim.divisor_timeline_cache[ bin_size_ ] = build_divisor_timeline( sim.simulation_length, bin_size_ );
+    AUTO_LOCK( sim.divisor_timeline_mutex );
+
+    // Check if we have divisor timeline cached
+    auto it = sim.divisor_timeline_cache.find( bin_size_ );
+    if ( it == sim.divisor_timeline_cache.end() )
+    {
+      // If we don't have a cached divisor timeline, build one
+      it = sim.divisor_timeline_cache.emplace( bin_size_, build_divisor_timeline( sim.simulation_length, bin_size_ ) ).first;
+    }
+
+    // Map elements are not moved by later insertions
+    divisor_timeline = &it->second;
   }
 
   // Do the timeline adjustement
-  timeline_t::adjust( sim.divisor_timeline_cache[ bin_size_ ] );
+  timeline_t::adjust( *divisor_timeline );
 }
 
 void sc_timeline_t::adjust( const extended_sample_data_t& adjustor )
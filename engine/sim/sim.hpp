@@ -10,7 +10,9 @@
 #include "player/gear_stats.hpp"
 #include "progress_bar.hpp"
 #include "sim_ostream.hpp"
+#include "sim/expressions.hpp"
 #include "sim/option.hpp"
+#include "sim/work_queue.hpp"
 #include "util/concurrency.hpp"
 #include "util/rng.hpp"
 #include "util/sample_data.hpp"
@@ -25,6 +27,7 @@ struct buff_t;
 struct cooldown_t;
 class dbc_t;
 class dbc_override_t;
+struct engine_profiler_t;
 struct expr_t;
 namespace highchart {
     struct chart_t;
@@ -129,6 +132,19 @@ struct sim_t : private sc_thread_t
   timespan_t  ignite_sampling_delta;
   int         optimize_expressions;
   int         optimize_expressions_rounds;
+  int         shared_aoe_snapshot;
+  int         apl_expression_compiler;
+  expression::compiled_stats_t apl_expression_stats;
+  // Reuse APL line conditions while their inputs are unchanged
+  int         apl_readiness_cache;
+  expression::cache_stats_t apl_readiness_stats;
+  // Engine profiling, see engine_profiler_t
+  int         profile_engine;
+  std::unique_ptr<engine_profiler_t> engine_profiler;
+  // Cache buff effect values of parse_buff_effects_t actions, see buff_stack_generation
+  int         buff_effects_cache;
+  // Incremented whenever the stack count of any buff changes
+  uint64_t    buff_stack_generation;
   int         current_slot;
   int         optimal_raid, log, debug_each;
   std::vector<uint64_t> debug_seed;
@@ -199,6 +215,10 @@ struct sim_t : private sc_thread_t
   uint64_t seed;
   int deterministic;
   int strict_work_queue;
+  // Common random numbers: seed every iteration from its key, so that the same iteration of
+  // compared sims (profilesets, scale factors) uses the same random numbers
+  int common_rng;
+  uint64_t iteration_key;
   int average_range, average_gauss;
 
   // Raid Events
@@ -587,10 +607,18 @@ struct sim_t : private sc_thread_t
   std::vector<player_t*> targets_by_name;
   std::vector<std::string> id_dictionary;
   std::map<double, std::vector<double> > divisor_timeline_cache;
+  // Timelines are adjusted concurrently in the analyze phases, see sc_timeline_t::adjust()
+  mutex_t divisor_timeline_mutex;
   std::vector<report::json::report_configuration_t> json_reports;
   std::string output_file_str, html_file_str, json_file_str;
+  std::string results_binary_file_str;
+  // Result snapshot written after merging ( snapshot= ), and the snapshots reported instead of simulating ( merge= )
+  std::string snapshot_file_str;
+  std::vector<std::string> merge_snapshot_files;
   std::string reforge_plot_output_file_str;
   std::vector<std::string> error_list;
+  // Errors are reported by concurrently running report writers, see errors()
+  mutable mutex_t error_mutex;
   int display_build;
   int report_precision;
   int report_pets_separately;
@@ -602,6 +630,7 @@ struct sim_t : private sc_thread_t
   int save_raid_summary;
   int save_gear_comments;
   int statistics_level;
+  bool streaming_sample_data;
   int separate_stats_by_actions;
   int report_raid_summary;
   int buff_uptime_timeline;
@@ -631,6 +660,39 @@ struct sim_t : private sc_thread_t
   computer_process::priority_e process_priority;
   
   std::shared_ptr<work_queue_t> work_queue;
+  work_queue_t::chunk_t work_chunk;
+
+  // Setup of a thread child sim, captured by sim_t::partition() in the parent thread and applied
+  // in the child's own thread so that children are set up concurrently
+  struct child_setup_t
+  {
+    sim_control_t* control;
+    int iterations;
+    stat_e scale_stat;
+    double scale_value;
+    gear_stats_t enchant;
+    uint64_t seed;
+  };
+  std::unique_ptr<child_setup_t> child_setup;
+  std::unique_ptr<sim_control_t> child_control;
+  // Merge thread children in a tree ( merge_tree=1, default ), or all of them in thread 0 in thread
+  // order ( merge_tree=0, the serial merge ). The tree adds the sums of the threads in another order
+  // than the serial merge, so merged results agree with it to floating point rounding ( a relative
+  // 1e-9 in tests/thread_merge.py ), but are not bitwise identical. Use merge_tree=0 for results
+  // that are bitwise identical between runs with a different merge strategy.
+  bool merge_tree;
+  // Thread child sims are merged pairwise in a tree, see sim_t::merge_subtree()
+  bool merge_ready;
+  std::vector<sim_t*> merged_sims;
+  // Wall time of merges per tree level, maximum over the concurrent merges of each level
+  std::vector<chrono::wall_clock::duration> merge_level_time;
+  // Wall time of the analyze phases run over the thread budget, see sim_t::analyze()
+  chrono::wall_clock::duration analyze_buff_time, analyze_stats_time, analyze_actor_time;
+  // Protects the sim-wide actor lists filled by concurrently analyzed actors
+  mutex_t analyze_mutex;
+  // Time from the start of execution to the first iteration, maximum over all threads
+  chrono::wall_clock::time_point execute_start;
+  chrono::wall_clock::duration startup_time;
 
   // Related Simulations
   mutex_t relatives_mutex;
@@ -654,6 +716,11 @@ struct sim_t : private sc_thread_t
   // to correct elements (toggled elements in the HTML report) based on the data.
   std::map<std::string, std::vector<std::string> > chart_data;
 
+  // Chart data of an HTML report section rendered on its own thread, added to the sim once the
+  // section is written to the report. Entries are ( toggle id, data ) tuples, on-ready charts have
+  // no toggle id.
+  using chart_data_buffer_t = std::vector<std::pair<std::string, std::string>>;
+
   bool chart_show_relative_difference;
   // Use the max metric actor as the relative difference base instead of the min
   bool relative_difference_from_max;
@@ -677,12 +744,16 @@ struct sim_t : private sc_thread_t
   std::vector<std::string> profileset_output_data;
   bool profileset_enabled;
   int profileset_work_threads, profileset_init_threads;
+  bool profileset_reuse_init;
+  // Racing of profilesets, disabled when profileset_race_iterations is 0
+  int profileset_race_iterations, profileset_race_rounds, profileset_race_top;
   std::unique_ptr<profileset::profilesets_t> profilesets;
 
 
   sim_t();
   sim_t( sim_t* parent, int thread_index = 0 );
   sim_t( sim_t* parent, int thread_index, sim_control_t* control );
+  sim_t( sim_t* parent, int thread_index, std::unique_ptr<child_setup_t> setup );
   ~sim_t() override;
 
   void run() override;
@@ -711,9 +782,11 @@ struct sim_t : private sc_thread_t
   void      analyze();
   void      merge( sim_t& other_sim );
   void      merge();
+  void      merge_subtree( bool success );
   bool      iterate();
   void      partition();
   bool      execute();
+  void      merge_snapshots();
   void      analyze_error();
   void      analyze_iteration_data();
   void      print_options();
@@ -721,6 +794,7 @@ struct sim_t : private sc_thread_t
   void      create_options();
   bool      parse_option( const std::string& name, const std::string& value );
   void      setup( sim_control_t* );
+  void      setup_child();
   bool      time_to_think( timespan_t proc_time );
   player_t* find_player( util::string_view name ) const;
   player_t* find_player( int index ) const;
@@ -751,11 +825,17 @@ struct sim_t : private sc_thread_t
     set_error( fmt::vformat( format, fmt::make_format_args( std::forward<Args>(args)... ) ) );
   }
 
+  // Copy of the errors reported so far
+  std::vector<std::string> errors() const;
   void abort();
   void combat();
   void combat_begin();
   void combat_end();
   void add_chart_data( const highchart::chart_t& chart );
+  void add_chart_data( const chart_data_buffer_t& buffer );
+  // Collect the chart data added by the calling thread into buffer instead of the sim, nullptr to
+  // add chart data to the sim again
+  static void buffer_chart_data( chart_data_buffer_t* buffer );
   bool has_raid_event( util::string_view type ) const;
 
   // Activates the necessary actor/actors before iteration begins.
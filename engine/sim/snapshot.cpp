@@ -0,0 +1,724 @@
+// ==========================================================================
+// Dedmonwakeen's Raid DPS/TPS Simulator.
+// Send questions to natehieter@gmail.com
+// ==========================================================================
+
+#include "snapshot.hpp"
+
+#include "action/action.hpp"
+#include "buff/buff.hpp"
+#include "player/player.hpp"
+#include "player/sample_data_helper.hpp"
+#include "player/spawner_base.hpp"
+#include "player/stats.hpp"
+#include "sim/benefit.hpp"
+#include "sim/cooldown.hpp"
+#include "sim/cooldown_waste_data.hpp"
+#include "sim/gain.hpp"
+#include "sim/iteration_data_entry.hpp"
+#include "sim/proc.hpp"
+#include "sim/sim.hpp"
+#include "sim/sim_control.hpp"
+#include "sim/uptime.hpp"
+#include "util/io.hpp"
+#include "util/timeline.hpp"
+
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+
+namespace
+{
+// All values are in the byte order and type sizes of the writing host, the format version is
+// checked on load.
+constexpr char SNAPSHOT_MAGIC[ 8 ] = { 'S', 'C', 'S', 'N', 'A', 'P', '\0', '\0' };
+constexpr uint32_t FORMAT_VERSION = 3;
+
+template <typename T>
+struct is_vector : std::false_type {};
+template <typename T, typename A>
+struct is_vector<std::vector<T, A>> : std::true_type {};
+
+template <typename T>
+struct is_array : std::false_type {};
+template <typename T, size_t N>
+struct is_array<std::array<T, N>> : std::true_type {};
+
+template <typename T>
+struct is_unique_ptr : std::false_type {};
+template <typename T>
+struct is_unique_ptr<std::unique_ptr<T>> : std::true_type {};
+
+// Containers that are merged as a whole, through their own merge()
+template <typename T>
+struct is_sample_data
+  : std::integral_constant<bool, std::is_base_of<simple_sample_data_t, T>::value || std::is_base_of<timeline_t, T>::value>
+{};
+
+// Writes the state of objects through their serialize() member
+class writer_t
+{
+  std::string buffer;
+
+public:
+  const std::string& data() const
+  { return buffer; }
+
+  template <typename... Ts>
+  void operator()( const Ts&... values )
+  { ( write( values ), ... ); }
+
+  void write_string( util::string_view str )
+  {
+    write( as<uint64_t>( str.size() ) );
+    buffer.append( str.data(), str.size() );
+  }
+
+  // Named objects are written as records of their own, so that a reader can skip objects it has no
+  // match for. The key function writes the fields identifying an object, the state function the
+  // state of an object beyond its serialize() member.
+  template <typename Container, typename Key>
+  void records( const Container& objects, Key&& key )
+  { records( objects, std::forward<Key>( key ), []( writer_t&, const auto& ) {} ); }
+
+  template <typename Container, typename Key, typename State>
+  void records( const Container& objects, Key&& key, State&& state )
+  {
+    write( as<uint64_t>( objects.size() ) );
+    for ( const auto& object : objects )
+    {
+      key( *this, *object );
+
+      writer_t record;
+      record( *object );
+      state( record, *object );
+      write_string( record.data() );
+    }
+  }
+
+private:
+  template <typename T>
+  void write( const T& value )
+  {
+    if constexpr ( std::is_arithmetic<T>::value || std::is_enum<T>::value )
+    {
+      buffer.append( reinterpret_cast<const char*>( &value ), sizeof( T ) );
+    }
+    else if constexpr ( std::is_same<T, std::string>::value )
+    {
+      write_string( value );
+    }
+    else if constexpr ( is_vector<T>::value )
+    {
+      write( as<uint64_t>( value.size() ) );
+      if constexpr ( std::is_arithmetic<typename T::value_type>::value )
+      {
+        buffer.append( reinterpret_cast<const char*>( value.data() ), value.size() * sizeof( typename T::value_type ) );
+      }
+      else
+      {
+        for ( const auto& v : value )
+          write( v );
+      }
+    }
+    else if constexpr ( is_array<T>::value )
+    {
+      for ( const auto& v : value )
+        write( v );
+    }
+    else if constexpr ( is_unique_ptr<T>::value )
+    {
+      write( value != nullptr );
+      if ( value )
+        write( *value );
+    }
+    else
+    {
+      // serialize() only reads the members when writing
+      const_cast<T&>( value ).serialize( *this );
+    }
+  }
+};
+
+// Reads the state written by writer_t, and merges it into existing objects. Sample data and timelines
+// are read into a container of their own and merged with their merge(), counters are added, plain
+// value vectors ( iteration keys ) are appended.
+class reader_t
+{
+  const char* pos;
+  const char* end;
+  bool merging;
+
+public:
+  reader_t( const char* data, size_t size ) : pos( data ), end( data + size ), merging( true )
+  { }
+
+  template <typename... Ts>
+  void operator()( Ts&... values )
+  { ( read( values ), ... ); }
+
+  bool done() const
+  { return pos == end; }
+
+  template <typename T>
+  T raw()
+  {
+    T value;
+    std::memcpy( &value, take( 1, sizeof( T ) ), sizeof( T ) );
+    return value;
+  }
+
+  std::string string()
+  {
+    auto size = raw<uint64_t>();
+    return std::string( take( size, 1 ), as<size_t>( size ) );
+  }
+
+  const char* bytes( uint64_t size )
+  { return take( size, 1 ); }
+
+  // Merges the records written by writer_t::records(). The find function reads the key fields of a
+  // record and returns the matching object, or nullptr to skip the record.
+  template <typename Find>
+  void records( Find&& find )
+  { records( std::forward<Find>( find ), []( reader_t&, auto& ) {} ); }
+
+  template <typename Find, typename State>
+  void records( Find&& find, State&& state )
+  {
+    for ( auto n = raw<uint64_t>(); n > 0; --n )
+    {
+      auto object = find( *this );
+      auto size   = raw<uint64_t>();
+      const char* data = take( size, 1 );
+      if ( object )
+      {
+        reader_t record( data, as<size_t>( size ) );
+        record( *object );
+        state( record, *object );
+        if ( !record.done() )
+        {
+          throw std::runtime_error( "Snapshot record does not match the simulation" );
+        }
+      }
+    }
+  }
+
+private:
+  const char* take( uint64_t count, size_t size )
+  {
+    if ( count > static_cast<uint64_t>( end - pos ) / size )
+    {
+      throw std::runtime_error( "Snapshot is truncated" );
+    }
+
+    const char* data = pos;
+    pos += count * size;
+    return data;
+  }
+
+  template <typename T>
+  void read( T& value )
+  {
+    if constexpr ( std::is_same<T, bool>::value || std::is_enum<T>::value )
+    {
+      value = raw<T>();
+    }
+    else if constexpr ( std::is_arithmetic<T>::value )
+    {
+      auto v = raw<T>();
+      value = merging ? value + v : v;
+    }
+    else if constexpr ( is_vector<T>::value )
+    {
+      read_vector( value );
+    }
+    else if constexpr ( is_array<T>::value )
+    {
+      for ( auto& v : value )
+        read( v );
+    }
+    else if constexpr ( is_unique_ptr<T>::value )
+    {
+      if ( raw<bool>() )
+      {
+        if ( !value )
+          value = std::make_unique<typename T::element_type>();
+        read( *value );
+      }
+    }
+    else if constexpr ( is_sample_data<T>::value )
+    {
+      if ( merging )
+        merge_into( value );
+      else
+        value.serialize( *this );
+    }
+    else
+    {
+      value.serialize( *this );
+    }
+  }
+
+  template <typename T>
+  void read_vector( std::vector<T>& values )
+  {
+    auto size = raw<uint64_t>();
+    if constexpr ( std::is_arithmetic<T>::value )
+    {
+      size_t offset = merging ? values.size() : 0;
+      const char* data = take( size, sizeof( T ) );
+      values.resize( offset + as<size_t>( size ) );
+      std::memcpy( values.data() + offset, data, as<size_t>( size ) * sizeof( T ) );
+    }
+    else
+    {
+      // Elements are merged pairwise, vectors that are only filled during combat ( resource
+      // timelines ) are created on the first merge
+      if ( !merging || values.empty() )
+        values.resize( as<size_t>( size ) );
+      else if ( values.size() != size )
+        throw std::runtime_error( "Snapshot does not match the simulation" );
+
+      for ( auto& v : values )
+        read( v );
+    }
+  }
+
+  template <typename T>
+  void read_plain( T& value )
+  {
+    merging = false;
+    value.serialize( *this );
+    merging = true;
+  }
+
+  void merge_into( simple_sample_data_t& target )
+  {
+    simple_sample_data_t other;
+    read_plain( other );
+    target.merge( other );
+  }
+
+  void merge_into( simple_sample_data_with_min_max_t& target )
+  {
+    simple_sample_data_with_min_max_t other;
+    read_plain( other );
+    target.merge( other );
+  }
+
+  void merge_into( extended_sample_data_t& target )
+  {
+    extended_sample_data_t other( target.name(), target.simple );
+    read_plain( other );
+    if ( other.simple != target.simple || other.streaming() != target.streaming() )
+    {
+      throw std::runtime_error( fmt::format( "'{}' was collected with different statistics options",
+                                             target.name() ) );
+    }
+    target.merge( other );
+  }
+
+  void merge_into( timeline_t& target )
+  {
+    timeline_t other;
+    read_plain( other );
+    target.merge( other );
+  }
+};
+
+// Class module state through the writer
+class archive_writer_t final : public snapshot::archive_t
+{
+  writer_t& w;
+
+public:
+  archive_writer_t( writer_t& w ) : w( w )
+  { }
+
+  void name( const std::string& name ) override
+  { w.write_string( name ); }
+
+  void item( double& value ) override
+  { w( value ); }
+
+  void item( simple_sample_data_t& data ) override
+  { w( data ); }
+
+  void item( simple_sample_data_with_min_max_t& data ) override
+  { w( data ); }
+
+  void item( extended_sample_data_t& data ) override
+  { w( data ); }
+
+  void item( timeline_t& timeline ) override
+  { w( timeline ); }
+
+protected:
+  size_t elements( size_t n ) override
+  {
+    w( as<uint64_t>( n ) );
+    return n;
+  }
+};
+
+// Class module state through the reader, merged into the objects of the sim
+class archive_reader_t final : public snapshot::archive_t
+{
+  reader_t& r;
+
+public:
+  archive_reader_t( reader_t& r ) : r( r )
+  { }
+
+  void name( const std::string& name ) override
+  {
+    auto snapshot_name = r.string();
+    if ( snapshot_name != name )
+    {
+      throw std::runtime_error( fmt::format( "Snapshot holds '{}' in place of '{}'", snapshot_name, name ) );
+    }
+  }
+
+  void item( double& value ) override
+  { r( value ); }
+
+  void item( simple_sample_data_t& data ) override
+  { r( data ); }
+
+  void item( simple_sample_data_with_min_max_t& data ) override
+  { r( data ); }
+
+  void item( extended_sample_data_t& data ) override
+  { r( data ); }
+
+  void item( timeline_t& timeline ) override
+  { r( timeline ); }
+
+protected:
+  size_t elements( size_t ) override
+  { return as<size_t>( r.raw<uint64_t>() ); }
+};
+
+// Options of a run that do not change its results, and the seed that is stored on its own
+constexpr util::string_view RUN_OPTIONS[] = {
+  "seed", "deterministic", "iterations", "target_error", "threads", "process_priority", "snapshot", "merge",
+  "output", "html", "json", "json2", "xml", "results_binary", "log", "debug", "report_details",
+};
+
+// FNV-1a hash of the profile options, in the order they were given
+uint64_t options_hash( const sim_t& sim )
+{
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  auto add = [ &hash ]( util::string_view str ) {
+    for ( unsigned char c : str )
+    {
+      hash ^= c;
+      hash *= 0x100000001b3ULL;
+    }
+    // Terminates the string, so that adjacent strings do not run together
+    hash ^= 0xff;
+    hash *= 0x100000001b3ULL;
+  };
+
+  if ( sim.control )
+  {
+    for ( const auto& option : sim.control->options )
+    {
+      if ( range::contains( RUN_OPTIONS, option.name ) )
+        continue;
+
+      add( option.scope );
+      add( option.name );
+      add( option.value );
+    }
+  }
+
+  return hash;
+}
+
+template <typename T>
+void write_name( writer_t& w, const T& object )
+{ w.write_string( object.name_str ); }
+
+// serialize_snapshot() only reads the members when writing
+void save_buff_state( writer_t& w, const buff_t& b )
+{
+  archive_writer_t ar( w );
+  const_cast<buff_t&>( b ).serialize_snapshot( ar );
+}
+
+void merge_buff_state( reader_t& r, buff_t& b )
+{
+  archive_reader_t ar( r );
+  b.serialize_snapshot( ar );
+}
+
+template <typename Container>
+auto find_named( const Container& objects, const std::string& name ) -> typename Container::value_type
+{
+  auto it = range::find( objects, name, []( const auto* object ) -> const std::string& { return object->name_str; } );
+  return it != objects.end() ? *it : nullptr;
+}
+
+void save_player( writer_t& w, const player_t& p )
+{
+  w( p.collected_data, p.iteration_resource_lost, p.iteration_resource_gained, p.iteration_resource_overflowed );
+
+  w.records( p.buff_list, []( writer_t& w, const buff_t& b ) {
+    w.write_string( b.name_str );
+    w.write_string( b.source_name() );
+  }, save_buff_state );
+  w.records( p.proc_list, write_name<proc_t> );
+  w.records( p.gain_list, write_name<gain_t> );
+  w.records( p.stats_list, write_name<stats_t> );
+  w.records( p.uptime_list, write_name<uptime_t> );
+  w.records( p.benefit_list, write_name<benefit_t> );
+  w.records( p.sample_data_list, write_name<sample_data_helper_t> );
+
+  w( as<uint64_t>( p.action_list.size() ) );
+  for ( const action_t* a : p.action_list )
+  {
+    w( a->internal_id, a->total_executions );
+  }
+
+  w.records( p.cooldown_waste_data_list, []( writer_t& w, const cooldown_waste_data_t& cd ) {
+    w.write_string( cd.cd->name_str );
+  } );
+
+  // serialize_snapshot() only reads the members when writing
+  archive_writer_t ar( w );
+  const_cast<player_t&>( p ).serialize_snapshot( ar );
+
+  // Dynamically spawned pets are saved with their spawner, in creation order
+  w( as<uint64_t>( p.spawners.size() ) );
+  for ( spawner::base_actor_spawner_t* spawner : p.spawners )
+  {
+    w.write_string( spawner->name() );
+    w( as<uint64_t>( spawner->n_snapshot_actors() ) );
+    for ( size_t i = 0, end = spawner->n_snapshot_actors(); i < end; ++i )
+    {
+      writer_t record;
+      save_player( record, *spawner->snapshot_actor( i ) );
+      w.write_string( record.data() );
+    }
+  }
+}
+
+void merge_player( reader_t& r, player_t& p, unsigned& skipped )
+{
+  r( p.collected_data, p.iteration_resource_lost, p.iteration_resource_gained, p.iteration_resource_overflowed );
+
+  r.records( [ &p, &skipped ]( reader_t& r ) -> buff_t* {
+    auto name   = r.string();
+    auto source = r.string();
+    auto it = range::find_if( p.buff_list, [ & ]( const buff_t* b ) {
+      return b->name_str == name && b->source_name() == source;
+    } );
+    if ( it == p.buff_list.end() )
+    {
+      ++skipped;
+      return nullptr;
+    }
+    return *it;
+  }, merge_buff_state );
+  r.records( [ &p ]( reader_t& r ) { return p.get_proc( r.string() ); } );
+  r.records( [ &p ]( reader_t& r ) { return p.get_gain( r.string() ); } );
+  r.records( [ &p ]( reader_t& r ) { return p.get_stats( r.string() ); } );
+  r.records( [ &p ]( reader_t& r ) { return p.get_uptime( r.string() ); } );
+  r.records( [ &p ]( reader_t& r ) { return p.get_benefit( r.string() ); } );
+  r.records( [ &p ]( reader_t& r ) { return p.get_sample_data( r.string() ); } );
+
+  for ( auto n = r.raw<uint64_t>(); n > 0; --n )
+  {
+    auto internal_id      = r.raw<int>();
+    auto total_executions = r.raw<uint_least64_t>();
+    auto it = range::find( p.action_list, internal_id, &action_t::internal_id );
+    if ( it != p.action_list.end() )
+      ( *it )->total_executions += total_executions;
+  }
+
+  r.records( [ &p, &skipped ]( reader_t& r ) -> cooldown_waste_data_t* {
+    auto name = r.string();
+    auto it = range::find_if( p.cooldown_waste_data_list, [ &name ]( const auto& cd ) {
+      return cd->cd->name_str == name;
+    } );
+    if ( it == p.cooldown_waste_data_list.end() )
+    {
+      ++skipped;
+      return nullptr;
+    }
+    return it->get();
+  } );
+
+  archive_reader_t ar( r );
+  p.serialize_snapshot( ar );
+
+  // Dynamically spawned pets are merged like spawner::merge() merges thread sims: pets are matched
+  // by creation order, and pets the sim does not have are created
+  for ( auto n = r.raw<uint64_t>(); n > 0; --n )
+  {
+    auto name    = r.string();
+    auto spawner = p.find_spawner( name );
+    if ( !spawner )
+    {
+      p.sim->error( "Snapshot pet spawner '{}' of '{}' is not part of the simulation, skipping.", name, p.name() );
+    }
+
+    auto n_actors = r.raw<uint64_t>();
+    for ( uint64_t i = 0; i < n_actors; ++i )
+    {
+      auto size = r.raw<uint64_t>();
+      auto data = r.bytes( size );
+
+      player_t* pet = spawner ? spawner->snapshot_actor( as<size_t>( i ) ) : nullptr;
+      if ( !pet )
+      {
+        continue;
+      }
+
+      reader_t record( data, as<size_t>( size ) );
+      merge_player( record, *pet, skipped );
+      if ( !record.done() )
+      {
+        throw std::runtime_error( fmt::format( "Snapshot pet '{}' of '{}' does not match the simulation",
+                                               pet->name(), p.name() ) );
+      }
+    }
+  }
+}
+}  // unnamed namespace
+
+namespace snapshot
+{
+void archive_t::size( size_t n )
+{
+  auto snapshot_size = elements( n );
+  if ( snapshot_size != n )
+  {
+    throw std::runtime_error( fmt::format( "Snapshot holds {} objects in place of {}", snapshot_size, n ) );
+  }
+}
+
+void save( const sim_t& sim, const std::string& path )
+{
+  writer_t w;
+
+  w.write_string( util::string_view( SNAPSHOT_MAGIC, sizeof( SNAPSHOT_MAGIC ) ) );
+  w( FORMAT_VERSION, options_hash( sim ), sim.seed );
+
+  w( sim.iterations, sim.event_mgr.total_events_processed, sim.simulation_length, sim.total_dmg, sim.raid_dps,
+     sim.total_heal, sim.raid_hps, sim.total_absorb, sim.raid_aps );
+
+  w.records( sim.buff_list, write_name<buff_t>, save_buff_state );
+
+  // Iteration data of deterministic runs, analyze() picks the lowest and highest iterations
+  w( as<uint64_t>( sim.iteration_data.size() ) );
+  for ( const auto& entry : sim.iteration_data )
+  {
+    w( entry.metric, entry.seed, entry.iteration, entry.iteration_length, entry.target_health );
+  }
+
+  // Dynamically spawned actors are saved with their spawner
+  std::vector<const player_t*> actors;
+  range::copy_if( sim.actor_list, std::back_inserter( actors ), []( const player_t* p ) { return !p->spawner; } );
+  w( as<uint64_t>( actors.size() ) );
+  for ( const player_t* p : actors )
+  {
+    w.write_string( p->name_str );
+
+    writer_t record;
+    save_player( record, *p );
+    w.write_string( record.data() );
+  }
+
+  io::cfile file( path, "wb" );
+  if ( !file || std::fwrite( w.data().data(), w.data().size(), 1, file ) != 1 )
+  {
+    throw std::runtime_error( fmt::format( "Unable to write snapshot '{}'", path ) );
+  }
+}
+
+uint64_t merge( sim_t& sim, const std::string& path )
+{
+  io::mapped_file file;
+  file.open( path );
+
+  reader_t r( file.data(), file.size() );
+  if ( r.string() != util::string_view( SNAPSHOT_MAGIC, sizeof( SNAPSHOT_MAGIC ) ) )
+  {
+    throw std::runtime_error( fmt::format( "'{}' is not a snapshot", path ) );
+  }
+
+  auto version = r.raw<uint32_t>();
+  if ( version != FORMAT_VERSION )
+  {
+    throw std::runtime_error( fmt::format( "Snapshot '{}' has format version {}, expected {}", path, version,
+                                           FORMAT_VERSION ) );
+  }
+
+  if ( r.raw<uint64_t>() != options_hash( sim ) )
+  {
+    throw std::runtime_error( fmt::format( "Snapshot '{}' was simulated with other profile options", path ) );
+  }
+  auto seed = r.raw<uint64_t>();
+
+  r( sim.iterations, sim.event_mgr.total_events_processed, sim.simulation_length, sim.total_dmg, sim.raid_dps,
+     sim.total_heal, sim.raid_hps, sim.total_absorb, sim.raid_aps );
+
+  unsigned skipped = 0;
+  r.records( [ &sim, &skipped ]( reader_t& r ) {
+    auto b = find_named( sim.buff_list, r.string() );
+    skipped += b == nullptr;
+    return b;
+  }, merge_buff_state );
+
+  for ( auto n = r.raw<uint64_t>(); n > 0; --n )
+  {
+    auto metric           = r.raw<double>();
+    auto entry_seed       = r.raw<uint64_t>();
+    auto iteration        = r.raw<uint64_t>();
+    auto iteration_length = r.raw<double>();
+    sim.iteration_data.emplace_back( metric, iteration_length, entry_seed, iteration );
+    for ( auto health = r.raw<uint64_t>(); health > 0; --health )
+    {
+      sim.iteration_data.back().add_health( r.raw<uint64_t>() );
+    }
+  }
+
+  for ( auto n = r.raw<uint64_t>(); n > 0; --n )
+  {
+    auto name = r.string();
+    auto size = r.raw<uint64_t>();
+    auto data = r.bytes( size );
+
+    player_t* p = sim.find_player( name );
+    if ( !p || p->spawner )
+    {
+      sim.error( "Snapshot '{}' actor '{}' is not part of the simulation, skipping.", path, name );
+      continue;
+    }
+
+    reader_t record( data, as<size_t>( size ) );
+    merge_player( record, *p, skipped );
+    if ( !record.done() )
+    {
+      throw std::runtime_error( fmt::format( "Snapshot '{}' actor '{}' does not match the simulation", path, name ) );
+    }
+  }
+
+  if ( !r.done() )
+  {
+    throw std::runtime_error( fmt::format( "Snapshot '{}' has trailing data", path ) );
+  }
+
+  if ( skipped > 0 )
+  {
+    sim.error( "Snapshot '{}' has {} buffs or cooldowns that are not part of the simulation, skipping them.", path,
+               skipped );
+  }
+
+  return seed;
+}
+} // namespace snapshot
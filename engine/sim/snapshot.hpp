@@ -0,0 +1,101 @@
+// ==========================================================================
+// Dedmonwakeen's Raid DPS/TPS Simulator.
+// Send questions to natehieter@gmail.com
+// ==========================================================================
+
+#pragma once
+
+#include "config.hpp"
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+class extended_sample_data_t;
+class simple_sample_data_t;
+class simple_sample_data_with_min_max_t;
+struct sim_t;
+struct timeline_t;
+
+/* Sim result snapshots ( snapshot=<file> ). A snapshot holds the merged, not yet analyzed result
+ * state of a simulation: the sim-wide sample data and buffs, and per actor the collected data, buffs,
+ * stats, procs, gains, uptimes, benefits, sample data, action execution counts and cooldown waste.
+ * Snapshots of independent runs of the same profile ( with different seeds ) are merged into one
+ * report with merge=<file>[,<file>...], exactly like the thread sims of a single run are merged.
+ *
+ * Objects are matched by name. Objects missing from the merging sim are created where the player
+ * can create them by name ( stats, gains, procs, uptimes, benefits, sample data ), other objects of a
+ * snapshot that the merging sim does not have are skipped. Dynamically spawned pets are saved with
+ * their spawner and matched by creation order, missing pets are created like in a thread merge.
+ * Result state of the class modules is passed through player_t::serialize_snapshot() and
+ * buff_t::serialize_snapshot(). The iteration data of deterministic runs is appended, so the
+ * lowest and highest iterations are picked from all snapshots. State of a single iteration
+ * ( buffed stats, the sample action sequence ) is not part of a snapshot.
+ *
+ * The header holds a hash of the profile options and the seed of the run. Snapshots are only merged
+ * into a sim with the same options, and only once per seed.
+ */
+namespace snapshot
+{
+/* Result state of a class module, see player_t::serialize_snapshot(). The same function saves and
+ * merges the state, like player_t::merge() merges the state of a thread sim: counters are added and
+ * sample data is merged.
+ */
+class archive_t
+{
+public:
+  virtual ~archive_t() = default;
+
+  template <typename... Ts>
+  void operator()( Ts&... values )
+  { ( item( values ), ... ); }
+
+  /// Name of the object that follows, merging throws if the snapshot holds another object
+  virtual void name( const std::string& name ) = 0;
+
+  /// Number of objects that follow, merging throws if the snapshot holds another number
+  void size( size_t n );
+
+  virtual void item( double& value ) = 0;
+  virtual void item( simple_sample_data_t& data ) = 0;
+  virtual void item( simple_sample_data_with_min_max_t& data ) = 0;
+  virtual void item( extended_sample_data_t& data ) = 0;
+  virtual void item( timeline_t& timeline ) = 0;
+
+  // Vectors filled during combat grow to the size of the snapshot
+  template <typename T, typename A>
+  void item( std::vector<T, A>& values )
+  {
+    size_t n = elements( values.size() );
+    if ( values.size() < n )
+      values.resize( n );
+
+    for ( size_t i = 0; i < n; ++i )
+      item( values[ i ] );
+  }
+
+  template <typename T, size_t N>
+  void item( std::array<T, N>& values )
+  {
+    for ( auto& v : values )
+      item( v );
+  }
+
+  template <typename T1, typename T2>
+  void item( std::pair<T1, T2>& values )
+  { ( *this )( values.first, values.second ); }
+
+protected:
+  /// Writes the number of elements that follow, or reads the number of elements in the snapshot
+  virtual size_t elements( size_t n ) = 0;
+};
+
+/// Write the result state of a simulated sim, throws on failure
+void save( const sim_t& sim, const std::string& path );
+
+/// Merge the result state of a snapshot into an initialized sim, throws on failure. Returns the seed
+/// the snapshot was simulated with.
+uint64_t merge( sim_t& sim, const std::string& path );
+} // namespace snapshot
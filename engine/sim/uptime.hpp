@@ -52,6 +52,12 @@ struct uptime_simple_t : public uptime_base_t
     uptime_sum.merge(other.uptime_sum);
   }
 
+  template <typename Archive>
+  void serialize(Archive& ar)
+  {
+    ar(uptime_sum);
+  }
+
   void datacollection_end(timespan_t t)
   {
     uptime_sum.add(t != timespan_t::zero() ? iteration_uptime_sum / t : 0.0);
@@ -90,6 +96,12 @@ struct uptime_t : public uptime_base_t
     uptime_instance.merge(other.uptime_instance);
   }
 
+  template <typename Archive>
+  void serialize(Archive& ar)
+  {
+    ar(uptime_sum, uptime_instance);
+  }
+
   void datacollection_end(timespan_t t)
   {
     uptime_sum.add(t != timespan_t::zero() ? iteration_uptime_sum / t : 0.0);
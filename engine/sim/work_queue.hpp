@@ -5,84 +5,167 @@
 
 #pragma once
 
+#include <atomic>
 #include <vector>
 #include <mutex>
 #include "util/generic.hpp"
 
 struct sim_progress_t;
 
+// Work queue, shared by all threads of a simulation unless deterministic or strict work queue
+// sims are used.
+//
+// Work is claimed without locking. When the queue is shared, threads claim a chunk of iterations
+// at a time, the chunk size shrinks with the remaining work so the tail of the simulation stays
+// balanced between threads. A queue with a single consumer always claims one iteration at a time.
+//
+// Single-actor batch sims use several indices of work (one per active actor), the queue moves to
+// the next index once the work of the current one has been claimed.
 struct work_queue_t
   {
     private:
+    static constexpr int MAX_CHUNK_SIZE = 32;
 #ifndef SC_NO_THREADING
-    std::recursive_mutex m;
-    using G = std::lock_guard<std::recursive_mutex>;
+    std::mutex m;
 #else
     struct no_m {
       void lock() {}
       void unlock() {}
     };
-    struct nop {
-      nop(no_m i) { (void)i; }
-    };
     no_m m;
-    using G = nop;
 #endif
+    // Incremented whenever the amount of work is reset, invalidates all claimed chunks
+    std::atomic<unsigned> _epoch;
+    int _consumers;
+    // Keys of simulated iterations, see sim_t::common_rng
+    std::atomic<uint64_t> _keys;
+
+    int chunk_size( int remaining ) const
+    {
+      if ( _consumers <= 1 )
+      {
+        return 1;
+      }
+
+      return clamp( remaining / ( 4 * _consumers ), 1, MAX_CHUNK_SIZE );
+    }
+
+    void advance( size_t idx )
+    {
+      if ( idx < _work.size() - 1 )
+      {
+        index.compare_exchange_strong( idx, idx + 1 );
+      }
+    }
+
     public:
-    std::vector<int> _total_work, _work, _projected_work;
-    size_t index;
+    // Range of work [next, end) of an index claimed by a single thread
+    struct chunk_t
+    {
+      size_t index = 0;
+      int next = 0, end = 0;
+      unsigned epoch = 0;
+    };
+
+    std::vector<std::atomic<int>> _total_work, _work, _projected_work;
+    std::atomic<size_t> index;
 
-    work_queue_t() : index( 0 )
-    { _total_work.resize( 1 ); _work.resize( 1 ); _projected_work.resize( 1 ); }
+    work_queue_t() : _epoch( 0 ), _consumers( 1 ), _keys( 0 ), _total_work( 1 ), _work( 1 ), _projected_work( 1 ), index( 0 )
+    { }
+
+    void init( int w )
+    {
+      for ( size_t i = 0; i < _total_work.size(); ++i )
+      {
+        _total_work[ i ] = w;
+        _projected_work[ i ] = w;
+      }
+      ++_epoch;
+    }
 
-    void init( int w )    { G l(m); range::fill( _total_work, w ); range::fill( _projected_work, w ); }
     // Single actor batch sim init methods. Batches is the number of active actors
-    void batches( size_t n ) { G l(m); _total_work.resize( n ); _work.resize( n ); _projected_work.resize( n ); }
+    void batches( size_t n )
+    {
+      _total_work = std::vector<std::atomic<int>>( n );
+      _work = std::vector<std::atomic<int>>( n );
+      _projected_work = std::vector<std::atomic<int>>( n );
+    }
+
+    // Number of threads sharing the queue, determines the chunk size
+    void consumers( int n ) { _consumers = n; }
+
+    void flush()
+    {
+      size_t idx = index;
+      _total_work[ idx ] = _projected_work[ idx ] = _work[ idx ].load();
+      ++_epoch;
+    }
+
+    int  size()           { size_t idx = index; return idx < _total_work.size() ? _total_work[ idx ] : _total_work.back(); }
+    bool more_work( const chunk_t& chunk )
+    {
+      if ( chunk.next < chunk.end && chunk.epoch == _epoch )
+      {
+        return true;
+      }
+
+      size_t idx = index;
+      return idx < _total_work.size() && _work[ idx ] < _total_work[ idx ];
+    }
 
-    void flush()          { G l(m); _total_work[ index ] = _projected_work[ index ] = _work[ index ]; }
-    int  size()           { G l(m); return index < _total_work.size() ? _total_work[ index ] : _total_work.back(); }
-    bool more_work()      { G l(m); return index < _total_work.size() && _work[ index ] < _total_work[ index ]; }
+    // Claim a unique key for the iteration about to be simulated
+    uint64_t claim_key()  { return _keys++; }
+
+    // Serializes work analysis (see sim_t::analyze_error), claiming work does not lock
     void lock()           { m.lock(); }
     void unlock()         { m.unlock(); }
 
     void project( int w )
     {
-      G l(m);
       _projected_work[ index ] = w;
-#ifdef NDEBUG
-      if ( w > _work[ index ] )
-      {
-      }
-#endif
     }
 
-    // Single-actor batch pop, uses several indices of work (per active actor), each thread has it's
-    // own state on what index it is simulating
-    size_t pop()
+    // Claim one unit of work, returns the index to simulate next
+    size_t pop( chunk_t& chunk )
     {
-      G l(m);
-
-      if ( _work[ index ] >= _total_work[ index ] )
+      if ( chunk.next >= chunk.end || chunk.epoch != _epoch )
       {
-        if ( index < _work.size() - 1 )
+        while ( true )
         {
-          ++index;
+          size_t idx = index;
+          unsigned epoch = _epoch;
+          int w = _work[ idx ];
+          int total = _total_work[ idx ];
+
+          if ( w >= total )
+          {
+            advance( idx );
+            chunk = chunk_t();
+            return index;
+          }
+
+          int n = std::min( chunk_size( total - w ), total - w );
+          if ( _work[ idx ].compare_exchange_weak( w, w + n ) )
+          {
+            chunk.index = idx;
+            chunk.next = w;
+            chunk.end = w + n;
+            chunk.epoch = epoch;
+            break;
+          }
         }
-        return index;
       }
 
-      if ( ++_work[ index ] == _total_work[ index ] )
+      size_t idx = chunk.index;
+      if ( ++chunk.next >= _total_work[ idx ] )
       {
-        _projected_work[ index ] = _work[ index ];
-        if ( index < _work.size() - 1 )
-        {
-          ++index;
-        }
+        _projected_work[ idx ] = _total_work[ idx ].load();
+        advance( idx );
         return index;
       }
 
-      return index;
+      return idx;
     }
 
     sim_progress_t progress( int idx = -1 );
-  };
\ No newline at end of file
+  };
@@ -98,6 +98,7 @@
 #include "sim/cooldown.hpp"
 #include "sim/gain.hpp"
 #include "sim/cooldown_waste_data.hpp"
+#include "sim/snapshot.hpp"
 
 #include "util/generic.hpp" // Generic programming tools
 #include "util/sample_data.hpp"
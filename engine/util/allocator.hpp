@@ -7,8 +7,10 @@
 
 #include <util/span.hpp>
 
+#include <array>
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <new>
 #include <type_traits>
@@ -112,4 +114,121 @@ private:
   std::vector<std::unique_ptr<page_t>> pages_;
 };
 
+// Allocates fixed-size blocks from a small set of size classes
+//
+// Each size class carves blocks out of its own pages and keeps a free list of
+// deallocated blocks, which are handed out again before any new page space is
+// used. Pages are aligned to PageSize, and start with a small header recording
+// the size class, so deallocate() does not need to know the size of the block.
+//
+// A freed block stores the free list link in its first pointer-sized bytes,
+// the rest of the block is left untouched until it is allocated again.
+template <size_t PageSize = 65536>
+class slab_allocator_t
+{
+  static_assert((PageSize & (PageSize - 1)) == 0, "Page size must be a power of two.");
+
+  static constexpr size_t BlockAlignment = alignof(std::max_align_t);
+  static constexpr std::array<size_t, 9> class_sizes = { { 64, 96, 128, 192, 256, 384, 512, 1024, 2048 } };
+public:
+  static constexpr size_t max_size = class_sizes.back();
+
+  slab_allocator_t() noexcept = default;
+
+  slab_allocator_t(const slab_allocator_t&) = delete;
+  slab_allocator_t& operator=(const slab_allocator_t&) = delete;
+  slab_allocator_t(slab_allocator_t&&) = delete;
+  slab_allocator_t& operator=(slab_allocator_t&&) = delete;
+
+  ~slab_allocator_t() {
+    for (void* page : pages_)
+      ::operator delete(page, std::align_val_t(PageSize));
+  }
+
+  void* allocate(size_t size) {
+    assert(size <= max_size && "The allocation does not fit in any size class");
+
+    const unsigned idx = class_index(size);
+    size_class_t& c = classes_[idx];
+    if (c.free_list) {
+      free_block_t* block = c.free_list;
+      c.free_list = block->next;
+      return block;
+    }
+
+    if (c.remaining < class_sizes[idx])
+      allocate_page(idx);
+
+    void* result = c.current;
+    c.current += class_sizes[idx];
+    c.remaining -= class_sizes[idx];
+    return result;
+  }
+
+  void deallocate(void* p) noexcept {
+    auto page = reinterpret_cast<page_header_t*>(reinterpret_cast<uintptr_t>(p) & ~(PageSize - 1));
+    size_class_t& c = classes_[page->size_class];
+
+    auto block = static_cast<free_block_t*>(p);
+    block->next = c.free_list;
+    c.free_list = block;
+  }
+
+  // True if an allocation of the given size is served from the free list
+  bool has_free_block(size_t size) const {
+    return classes_[class_index(size)].free_list != nullptr;
+  }
+
+  // Size of the block handed out for an allocation of the given size
+  static constexpr size_t block_size(size_t size) {
+    return class_sizes[class_index(size)];
+  }
+
+  // Total amount of memory reserved from the system
+  size_t reserved_bytes() const {
+    return pages_.size() * PageSize;
+  }
+
+private:
+  struct page_header_t {
+    unsigned size_class;
+  };
+
+  struct free_block_t {
+    free_block_t* next;
+  };
+
+  struct size_class_t {
+    free_block_t* free_list = nullptr;
+    char* current = nullptr; // next unused block in the current page
+    size_t remaining = 0; // number of bytes left in the current page
+  };
+
+  static constexpr size_t HeaderSize = (sizeof(page_header_t) + BlockAlignment - 1) & ~(BlockAlignment - 1);
+  static_assert(HeaderSize + class_sizes.back() <= PageSize, "The largest size class does not fit in a page.");
+
+  static constexpr unsigned class_index(size_t size) {
+    unsigned idx = 0;
+    while (idx < class_sizes.size() - 1 && class_sizes[idx] < size)
+      ++idx;
+    return idx;
+  }
+
+  void allocate_page(unsigned idx) {
+    pages_.emplace_back();
+    void* page = ::operator new(PageSize, std::align_val_t(PageSize));
+    pages_.back() = page;
+
+    auto header = ::new(page) page_header_t();
+    header->size_class = idx;
+
+    size_class_t& c = classes_[idx];
+    c.current = static_cast<char*>(page) + HeaderSize;
+    c.remaining = PageSize - HeaderSize;
+  }
+
+  std::array<size_class_t, class_sizes.size()> classes_;
+  std::vector<void*> pages_;
+};
+
 } // namespace util
@@ -13,9 +13,14 @@
 
 #include "config.hpp"
 #include "util/generic.hpp"
+#include <algorithm>
+#include <exception>
 #include <memory>
+#include <vector>
 
 #ifndef SC_NO_THREADING
+#include <atomic>
+#include <mutex>
 #include <thread>
 #endif
 
@@ -81,4 +86,64 @@ namespace thread
 {
   // Windows (10) needs to promote main thread to higher priority
   void set_main_thread_priority();
+
+  // Call fn for every item, spread over up to n_threads threads ( including the calling thread ).
+  // Items are claimed in order, but may finish in any order, so they must not depend on each other.
+  // The first exception thrown by fn is rethrown once all items are done.
+  template <typename T, typename Fn>
+  void parallel_for_each( const std::vector<T>& items, int n_threads, const Fn& fn )
+  {
+#ifndef SC_NO_THREADING
+    size_t n_workers = std::min( items.size(), static_cast<size_t>( std::max( n_threads, 1 ) ) );
+    if ( n_workers > 1 )
+    {
+      std::atomic<size_t> next_item( 0 );
+      std::mutex error_mutex;
+      std::exception_ptr error;
+
+      auto worker = [ & ]() {
+        for ( size_t i = next_item++; i < items.size(); i = next_item++ )
+        {
+          try
+          {
+            fn( items[ i ] );
+          }
+          catch ( ... )
+          {
+            std::lock_guard<std::mutex> lock( error_mutex );
+            if ( !error )
+            {
+              error = std::current_exception();
+            }
+          }
+        }
+      };
+
+      std::vector<std::thread> workers;
+      for ( size_t i = 1; i < n_workers; ++i )
+      {
+        workers.emplace_back( worker );
+      }
+
+      worker();
+
+      for ( auto& worker_thread : workers )
+      {
+        worker_thread.join();
+      }
+
+      if ( error )
+      {
+        std::rethrow_exception( error );
+      }
+
+      return;
+    }
+#endif
+
+    for ( const auto& item : items )
+    {
+      fn( item );
+    }
+  }
 }
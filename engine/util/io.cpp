@@ -9,10 +9,16 @@
 #include <cassert>
 #include <cstring>
 #include <cstdarg>
+#include <stdexcept>
 
 #ifdef SC_WINDOWS
 #include <windows.h>
 #include <shellapi.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #endif
 
 namespace io { // ===========================================================
@@ -171,6 +177,94 @@ bool ifstream::open( const std::string& filename, const std::vector<std::string>
   return false;
 }
 
+#ifdef SC_WINDOWS
+mapped_file::mapped_file() : file_handle( INVALID_HANDLE_VALUE )
+{ }
+
+mapped_file::~mapped_file()
+{
+  if ( base )
+    UnmapViewOfFile( base );
+  if ( mapping_handle )
+    CloseHandle( mapping_handle );
+  if ( file_handle != INVALID_HANDLE_VALUE )
+    CloseHandle( file_handle );
+}
+
+void mapped_file::open( const std::string& filename )
+{
+  file_handle = CreateFileW( widen( filename ).c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                             FILE_ATTRIBUTE_NORMAL, nullptr );
+  if ( file_handle == INVALID_HANDLE_VALUE )
+  {
+    throw std::runtime_error( fmt::format( "Unable to open '{}'", filename ) );
+  }
+
+  LARGE_INTEGER size;
+  if ( !GetFileSizeEx( file_handle, &size ) )
+  {
+    throw std::runtime_error( fmt::format( "Unable to read the size of '{}'", filename ) );
+  }
+  file_size = static_cast<size_t>( size.QuadPart );
+
+  if ( file_size > 0 )
+  {
+    mapping_handle = CreateFileMappingW( file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr );
+    if ( mapping_handle )
+    {
+      base = static_cast<const char*>( MapViewOfFile( mapping_handle, FILE_MAP_READ, 0, 0, 0 ) );
+    }
+  }
+
+  if ( !base )
+  {
+    throw std::runtime_error( fmt::format( "Unable to map '{}'", filename ) );
+  }
+}
+#else
+mapped_file::mapped_file() = default;
+
+mapped_file::~mapped_file()
+{
+  if ( base )
+    munmap( const_cast<char*>( base ), file_size );
+}
+
+void mapped_file::open( const std::string& filename )
+{
+  int fd = ::open( filename.c_str(), O_RDONLY );
+  if ( fd < 0 )
+  {
+    throw std::runtime_error( fmt::format( "Unable to open '{}'", filename ) );
+  }
+
+  struct stat st;
+  if ( fstat( fd, &st ) != 0 )
+  {
+    ::close( fd );
+    throw std::runtime_error( fmt::format( "Unable to read the size of '{}'", filename ) );
+  }
+  file_size = static_cast<size_t>( st.st_size );
+
+  if ( file_size > 0 )
+  {
+    void* addr = mmap( nullptr, file_size, PROT_READ, MAP_SHARED, fd, 0 );
+    if ( addr != MAP_FAILED )
+    {
+      base = static_cast<const char*>( addr );
+    }
+  }
+
+  // The mapping stays valid after the descriptor is closed
+  ::close( fd );
+
+  if ( !base )
+  {
+    throw std::runtime_error( fmt::format( "Unable to map '{}'", filename ) );
+  }
+}
+#endif
+
 #ifdef SC_WINDOWS
 utf8_args::utf8_args( int, char** )
 {
@@ -99,6 +99,34 @@ public:
   bool open( const std::string& filename, const std::vector<std::string>& prefix, openmode mode = in );
 };
 
+// Read-only memory mapping of a whole file. The pages of the mapping are shared by all threads, and
+// by all processes mapping the same file.
+class mapped_file
+{
+  const char* base = nullptr;
+  size_t      file_size = 0;
+#ifdef SC_WINDOWS
+  void*       file_handle;
+  void*       mapping_handle = nullptr;
+#endif
+
+public:
+  mapped_file();
+  ~mapped_file();
+
+  mapped_file( const mapped_file& ) = delete;
+  mapped_file& operator=( const mapped_file& ) = delete;
+
+  // Map a file, throws on failure
+  void open( const std::string& filename );
+
+  const char* data() const
+  { return base; }
+
+  size_t size() const
+  { return file_size; }
+};
+
 class utf8_args : public std::vector<std::string>
 {
 public:
@@ -0,0 +1,88 @@
+// ==========================================================================
+// Dedmonwakeen's Raid DPS/TPS Simulator.
+// Send questions to natehieter@gmail.com
+// ==========================================================================
+
+#ifndef SC_NAME_REGISTRY_HPP
+#define SC_NAME_REGISTRY_HPP
+
+#include "config.hpp"
+
+#include <cassert>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include "util/string_view.hpp"
+
+/* Hashed name lookup over a list of named objects ( name_str ), such as the cooldowns or buffs of a
+ * player. The list stays the owner and defines the order, the registry only indexes it by name hash.
+ * Objects appended to the list are indexed with add(). Any other change to the list ( erase, insert,
+ * sort ) must be followed by rebuild(). Lookups never modify the registry, so a const player can be
+ * searched from several threads. Lookups return the first matching object in list order, like a
+ * linear search.
+ *
+ * Candidates are compared by name, so hash collisions and objects renamed after they were indexed
+ * never produce a wrong match. A renamed object is however not found under its new name, lookups in
+ * lists whose objects may be renamed ( actions ) fall back to a linear search on a miss.
+ */
+template <typename T>
+class name_registry_t
+{
+  std::unordered_map<size_t, std::vector<T*>> index;
+  size_t indexed = 0;
+
+  static size_t hash( util::string_view name )
+  { return std::hash<util::string_view>()( name ); }
+
+public:
+  /// Index an object appended to the list
+  void add( T* t )
+  {
+    index[ hash( t->name_str ) ].push_back( t );
+    ++indexed;
+  }
+
+  /// Index the list again after it was changed other than by appending
+  void rebuild( const std::vector<T*>& list )
+  {
+    index.clear();
+    indexed = 0;
+    for ( T* t : list )
+    {
+      add( t );
+    }
+  }
+
+  template <typename Predicate>
+  T* find( const std::vector<T*>& list, util::string_view name, Predicate&& pred, bool fallback_search = false ) const
+  {
+    assert( list.size() == indexed && "name_registry_t list changed without add() or rebuild()" );
+
+    auto it = index.find( hash( name ) );
+    if ( it != index.end() )
+    {
+      for ( T* t : it->second )
+      {
+        if ( t->name_str == name && pred( *t ) )
+          return t;
+      }
+    }
+
+    if ( fallback_search )
+    {
+      for ( T* t : list )
+      {
+        if ( t->name_str == name && pred( *t ) )
+          return t;
+      }
+    }
+
+    return nullptr;
+  }
+
+  T* find( const std::vector<T*>& list, util::string_view name, bool fallback_search = false ) const
+  { return find( list, name, []( const T& ) { return true; }, fallback_search ); }
+};
+
+#endif // SC_NAME_REGISTRY_HPP
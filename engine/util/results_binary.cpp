@@ -0,0 +1,92 @@
+// ==========================================================================
+// Dedmonwakeen's Raid DPS/TPS Simulator.
+// Send questions to natehieter@gmail.com
+// ==========================================================================
+
+#include "results_binary.hpp"
+
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+
+#include "fmt/format.h"
+
+namespace results_binary
+{
+reader_t::reader_t( std::string path ) : file_path( std::move( path ) )
+{ }
+
+std::unique_ptr<reader_t> reader_t::open( const std::string& path )
+{
+  std::unique_ptr<reader_t> reader( new reader_t( path ) );
+  try
+  {
+    reader->file.open( path );
+  }
+  catch ( const std::exception& )
+  {
+    std::throw_with_nested( std::runtime_error( fmt::format( "Unable to load results file '{}'", path ) ) );
+  }
+  reader->validate();
+  return reader;
+}
+
+void reader_t::validate() const
+{
+  if ( file.size() < sizeof( header_t ) || std::memcmp( header().magic, MAGIC, sizeof( MAGIC ) ) != 0 )
+  {
+    throw std::runtime_error( fmt::format( "'{}' is not a results file", file_path ) );
+  }
+
+  if ( header().format_version != FORMAT_VERSION )
+  {
+    throw std::runtime_error( fmt::format( "Results file '{}' has format version {}, expected {}", file_path,
+                                           header().format_version, FORMAT_VERSION ) );
+  }
+
+  uint64_t string_table_offset = header().string_table_offset;
+  if ( sizeof( header_t ) + uint64_t( header().column_count ) * sizeof( column_entry_t ) > string_table_offset ||
+       string_table_offset > file.size() )
+  {
+    throw std::runtime_error( fmt::format( "Results file '{}' is truncated", file_path ) );
+  }
+
+  for ( const auto& entry : entries() )
+  {
+    if ( string_table_offset + entry.actor_offset + entry.actor_length > file.size() ||
+         string_table_offset + entry.metric_offset + entry.metric_length > file.size() )
+    {
+      throw std::runtime_error( fmt::format( "Results file '{}' has an invalid column name", file_path ) );
+    }
+
+    if ( entry.offset % ALIGNMENT != 0 || entry.offset > file.size() ||
+         entry.row_count > ( file.size() - entry.offset ) / sizeof( double ) )
+    {
+      throw std::runtime_error( fmt::format( "Results file '{}' column '{}' is out of bounds", file_path,
+                                             string( entry.metric_offset, entry.metric_length ) ) );
+    }
+  }
+}
+
+column_t reader_t::column( size_t index ) const
+{
+  const auto& entry = entries()[ index ];
+
+  return { string( entry.actor_offset, entry.actor_length ), string( entry.metric_offset, entry.metric_length ),
+           { reinterpret_cast<const double*>( file.data() + entry.offset ), static_cast<size_t>( entry.row_count ) } };
+}
+
+util::span<const double> reader_t::column( util::string_view actor, util::string_view metric ) const
+{
+  for ( const auto& entry : entries() )
+  {
+    if ( string( entry.actor_offset, entry.actor_length ) == actor &&
+         string( entry.metric_offset, entry.metric_length ) == metric )
+    {
+      return { reinterpret_cast<const double*>( file.data() + entry.offset ), static_cast<size_t>( entry.row_count ) };
+    }
+  }
+
+  return {};
+}
+} // Namespace results_binary ends
@@ -0,0 +1,107 @@
+// ==========================================================================
+// Dedmonwakeen's Raid DPS/TPS Simulator.
+// Send questions to natehieter@gmail.com
+// ==========================================================================
+
+#ifndef SC_RESULTS_BINARY_HPP
+#define SC_RESULTS_BINARY_HPP
+
+#include "config.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "util/io.hpp"
+#include "util/span.hpp"
+#include "util/string_view.hpp"
+
+/* Columnar binary per-iteration results ( results_binary=<file> ). The file holds one column of
+ * doubles per metric and actor, in the order the iterations were collected. Columns of the same
+ * actor and the sim-scope columns have one row per iteration, except event columns such as the
+ * time of each death, which have one row per event. Sample data that is not stored per iteration
+ * ( statistics_level, streaming_sample_data ) has no column.
+ *
+ * All values are in the byte order of the writing host ( little endian on all supported
+ * platforms ), a mismatching byte order reads as a wrong format version:
+ *
+ *   header:       header_t
+ *   directory:    <column count> column_entry_t
+ *   string table: actor and metric names referenced by the directory, not NUL terminated
+ *   columns:      <row count> doubles per column, each column aligned to 16 bytes
+ *
+ * Sim-scope columns ( raid_dps, simulation_length ) have an empty actor name.
+ */
+namespace results_binary
+{
+constexpr char     MAGIC[ 8 ]     = { 'S', 'C', 'R', 'E', 'S', 'B', 'I', 'N' };
+constexpr uint32_t FORMAT_VERSION = 1;
+constexpr uint64_t ALIGNMENT      = 16;
+
+struct header_t
+{
+  char     magic[ 8 ];
+  uint32_t format_version;
+  uint32_t column_count;
+  uint64_t iterations;
+  uint64_t string_table_offset;
+};
+
+struct column_entry_t
+{
+  uint32_t actor_offset;
+  uint32_t actor_length;
+  uint32_t metric_offset;
+  uint32_t metric_length;
+  uint64_t row_count;
+  uint64_t offset;
+};
+
+struct column_t
+{
+  util::string_view        actor;
+  util::string_view        metric;
+  util::span<const double> rows;
+};
+
+/// Memory mapped reader of a results file, the columns are used in place
+class reader_t
+{
+public:
+  reader_t( const reader_t& ) = delete;
+  reader_t& operator=( const reader_t& ) = delete;
+
+  /// Map and validate a results file, throws on failure
+  static std::unique_ptr<reader_t> open( const std::string& path );
+
+  uint64_t iterations() const
+  { return header().iterations; }
+
+  size_t column_count() const
+  { return header().column_count; }
+
+  column_t column( size_t index ) const;
+
+  /// Rows of the metric of an actor ( empty name for the sim ), empty if the file has no such column
+  util::span<const double> column( util::string_view actor, util::string_view metric ) const;
+
+private:
+  std::string     file_path;
+  io::mapped_file file;
+
+  explicit reader_t( std::string path );
+
+  const header_t& header() const
+  { return *reinterpret_cast<const header_t*>( file.data() ); }
+
+  util::span<const column_entry_t> entries() const
+  { return { reinterpret_cast<const column_entry_t*>( file.data() + sizeof( header_t ) ), header().column_count }; }
+
+  util::string_view string( uint32_t offset, uint32_t length ) const
+  { return { file.data() + header().string_table_offset + offset, length }; }
+
+  void validate() const;
+};
+} // Namespace results_binary ends
+
+#endif // SC_RESULTS_BINARY_HPP
@@ -6,13 +6,17 @@
 #ifndef SAMPLE_DATA_HPP
 #define SAMPLE_DATA_HPP
 
+#include <algorithm>
+#include <cstdint>
 #include <limits>
 #include <numeric>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "util/generic.hpp"
 #include "util/string_view.hpp"
+#include "util/tdigest.hpp"
 
 /* Collection of statistical formulas for sequences
  * Note: Returns 0 for empty sequences
@@ -188,6 +192,69 @@ inline std::vector<double> normalize_histogram( const std::vector<size_t>& in )
   return normalize_histogram( in, count );
 }
 
+/* Difference b - a of two paired samples ( common random numbers ). Sample i of a and sample j of
+ * b are paired when their keys are equal, unpaired samples are ignored. The variance reduction is
+ * the ratio of the mean variance of independent samples to the mean variance of the paired
+ * difference, ie. how many times more iterations independent sims would need for the same error.
+ */
+struct paired_difference_t
+{
+  double mean = 0;
+  double mean_std_dev = 0;
+  double variance_reduction = 0;
+  size_t count = 0;
+};
+
+template <typename Keys, typename Range>
+paired_difference_t paired_difference( const Keys& keys_a, const Range& a,
+                                       const Keys& keys_b, const Range& b )
+{
+  paired_difference_t result;
+
+  if ( std::size( keys_a ) != std::size( a ) || std::size( keys_b ) != std::size( b ) ||
+       std::size( a ) < 2 || std::size( b ) < 2 )
+  {
+    return result;
+  }
+
+  std::vector<std::pair<uint64_t, double>> sorted_b;
+  sorted_b.reserve( std::size( b ) );
+  for ( size_t i = 0; i < std::size( b ); ++i )
+  {
+    sorted_b.emplace_back( keys_b[ i ], b[ i ] );
+  }
+  std::sort( sorted_b.begin(), sorted_b.end() );
+
+  std::vector<double> diff;
+  diff.reserve( std::min( std::size( a ), std::size( b ) ) );
+  for ( size_t i = 0; i < std::size( a ); ++i )
+  {
+    auto it = std::lower_bound( sorted_b.begin(), sorted_b.end(), std::make_pair( keys_a[ i ], -std::numeric_limits<double>::infinity() ) );
+    if ( it != sorted_b.end() && it->first == keys_a[ i ] )
+    {
+      diff.push_back( it->second - a[ i ] );
+    }
+  }
+
+  if ( diff.size() < 2 )
+  {
+    return result;
+  }
+
+  result.count        = diff.size();
+  result.mean         = calculate_mean( diff );
+  result.mean_std_dev = calculate_mean_stddev( diff, result.mean );
+
+  double independent = calculate_variance( a ) / std::size( a ) + calculate_variance( b ) / std::size( b );
+  double paired      = result.mean_std_dev * result.mean_std_dev;
+  if ( paired > 0 )
+  {
+    result.variance_reduction = independent / paired;
+  }
+
+  return result;
+}
+
 }  // end sd namespace
 
 /* Simplest Samplest Data container. Only tracks sum and count
@@ -247,6 +314,13 @@ public:
     _count = 0u;
     _sum   = 0.0;
   }
+
+  // Sample data containers are written to and merged from snapshots as a whole, see sim/snapshot.cpp
+  template <typename Archive>
+  void serialize( Archive& ar )
+  {
+    ar( _sum, _count );
+  }
 };
 
 /* Second simplest Samplest Data container. Tracks sum, count as well as min/max
@@ -302,11 +376,23 @@ public:
     _min = std::numeric_limits<value_t>::max();
     _max = std::numeric_limits<value_t>::lowest();
   }
+
+  template <typename Archive>
+  void serialize( Archive& ar )
+  {
+    base_t::serialize( ar );
+    ar( _min, _max );
+  }
 };
 
 /* Extensive sample_data container with two runtime dependent modes:
  * - simple: Only offers sum, count
  *  -!simple: saves data and offers variance, percentiles, distribution, etc.
+ *
+ * A !simple container can additionally be put into streaming mode, where it uses constant memory
+ * instead of storing every sample. Mean and variance are tracked exactly ( Welford ), percentiles
+ * and the distribution are estimated from a t-digest ( see tdigest_t for the error bound ). In
+ * streaming mode data() and sorted_data() are empty.
  */
 class extended_sample_data_t : public simple_sample_data_with_min_max_t
 {
@@ -326,6 +412,11 @@ private:
                                       // to do regression on it )
   bool is_sorted;
 
+  // Streaming mode state
+  bool _streaming;
+  value_t _running_mean, _m2;
+  tdigest_t _digest;
+
 public:
   explicit extended_sample_data_t( util::string_view n, bool s = true )
     : base_t(),
@@ -336,7 +427,10 @@ public:
       mean_variance(),
       mean_std_dev(),
       simple( s ),
-      is_sorted( false )
+      is_sorted( false ),
+      _streaming( false ),
+      _running_mean(),
+      _m2()
   {
   }
 
@@ -347,6 +441,20 @@ public:
     clear();
   }
 
+  // Use constant memory estimators instead of storing the samples. Has no effect on simple
+  // containers.
+  void set_streaming( bool s )
+  {
+    _streaming = s;
+
+    clear();
+  }
+
+  bool streaming() const
+  {
+    return !simple && _streaming;
+  }
+
   const std::string& name() const
   {
     return name_str;
@@ -355,7 +463,7 @@ public:
   // Reserve memory
   void reserve( std::size_t capacity )
   {
-    if ( !simple )
+    if ( !simple && !_streaming )
       _data.reserve( capacity );
   }
 
@@ -366,6 +474,15 @@ public:
     {
       base_t::add( x );
     }
+    else if ( _streaming )
+    {
+      base_t::add( x );
+      auto delta = x - _running_mean;
+      _running_mean += delta / base_t::count();
+      _m2 += delta * ( x - _running_mean );
+      _digest.add( x );
+      is_sorted = false;
+    }
     else
     {
       _data.push_back( x );
@@ -380,7 +497,7 @@ public:
 
   size_t size() const
   {
-    if ( simple )
+    if ( simple || _streaming )
       return base_t::count();
 
     return _data.size();
@@ -405,6 +522,12 @@ public:
     if ( simple )
       return;
 
+    if ( _streaming )
+    {
+      _mean = _running_mean;
+      return;
+    }
+
     if ( data().empty() )
       return;
 
@@ -434,7 +557,7 @@ public:
   }
   size_t count() const
   {
-    return simple ? base_t::count() : data().size();
+    return simple || _streaming ? base_t::count() : data().size();
   }
 
   /* Analyze Variance: Variance, Stddev and Stddev of the mean
@@ -445,16 +568,19 @@ public:
     if ( simple )
       return;
 
-    if ( _data.empty() )
+    if ( size() == 0 )
       return;
 
-    variance = statistics::calculate_variance( data(), mean() );
+    if ( _streaming )
+      variance = _m2 / size();
+    else
+      variance = statistics::calculate_variance( data(), mean() );
     std_dev  = std::sqrt( variance );
 
     // Calculate Standard Deviation of the Mean ( Central Limit Theorem )
-    if ( data().size() > 1 )
+    if ( size() > 1 )
     {
-      mean_variance = variance / data().size();
+      mean_variance = variance / size();
       mean_std_dev  = std::sqrt( mean_variance );
     }
   }
@@ -471,6 +597,12 @@ public:
     {
       return;
     }
+    if ( _streaming )
+    {
+      _digest.compress();
+      is_sorted = true;
+      return;
+    }
     _sorted_data = _data;
     range::sort( _sorted_data );
     is_sorted = true;
@@ -485,11 +617,45 @@ public:
     if ( simple )
       return;
 
-    if ( data().empty() )
+    if ( size() == 0 )
       return;
 
-    distribution = statistics::create_histogram( data(), num_buckets,
-                                                 base_t::min(), base_t::max() );
+    distribution = histogram( num_buckets, base_t::min(), base_t::max() );
+  }
+
+  /* Histogram ( not normalized ) of the data with given min/max. In streaming mode the bucket
+   * counts are estimated from the cumulative distribution of the digest, they still add up to the
+   * number of samples.
+   *
+   * Requires: sorted data in streaming mode
+   */
+  std::vector<size_t> histogram( size_t num_buckets, value_t min, value_t max ) const
+  {
+    if ( !_streaming )
+      return statistics::create_histogram( data(), num_buckets, min, max );
+
+    std::vector<size_t> result;
+    if ( size() == 0 || std::isnan( min ) || std::isnan( max ) || max <= min )
+      return result;
+
+    assert( _digest.compressed() );
+
+    result.reserve( num_buckets );
+    size_t previous = 0;
+    for ( size_t i = 1; i <= num_buckets; ++i )
+    {
+      size_t cumulative = size();
+      if ( i < num_buckets )
+      {
+        auto edge  = min + ( max - min ) * i / num_buckets;
+        cumulative = static_cast<size_t>( std::round( _digest.cdf( edge ) * size() ) );
+        cumulative = std::max( previous, std::min( cumulative, size() ) );
+      }
+      result.push_back( cumulative - previous );
+      previous = cumulative;
+    }
+
+    return result;
   }
 
   void clear()
@@ -498,6 +664,8 @@ public:
     _sorted_data.clear();
     _data.clear();
     distribution.clear();
+    _running_mean = _m2 = value_t();
+    _digest.clear();
   }
 
   // Access functions
@@ -510,12 +678,15 @@ public:
     if ( simple )
       return 0;
 
-    if ( data().empty() )
+    if ( !_streaming && data().empty() )
       return 0;
 
     if ( !is_sorted )
       return base_t::nan();
 
+    if ( _streaming )
+      return size() ? _digest.quantile( x ) : 0;
+
     // Should be improved to use linear interpolation
     return ( sorted_data()[ (int)( x * ( sorted_data().size() - 1 ) ) ] );
   }
@@ -532,15 +703,38 @@ public:
   void merge( const extended_sample_data_t& other )
   {
     assert( simple == other.simple );
+    assert( _streaming == other._streaming );
 
     if ( simple )
     {
       base_t::merge( other );
     }
+    else if ( _streaming )
+    {
+      // Chan et al. parallel combination of the running mean and squared deviations
+      auto n_a   = static_cast<value_t>( count() );
+      auto n_b   = static_cast<value_t>( other.count() );
+      if ( n_b == 0 )
+        return;
+      auto delta = other._running_mean - _running_mean;
+      auto n     = n_a + n_b;
+      _running_mean += delta * n_b / n;
+      _m2 += other._m2 + delta * delta * n_a * n_b / n;
+      base_t::merge( other );
+      _digest.merge( other._digest );
+      is_sorted = false;
+    }
     else
       _data.insert( _data.end(), other._data.begin(), other._data.end() );
   }
 
+  template <typename Archive>
+  void serialize( Archive& ar )
+  {
+    base_t::serialize( ar );
+    ar( simple, _streaming, _data, _running_mean, _m2, _digest );
+  }
+
 };  // sample_data_t
 
 #endif  // SAMPLE_DATA_HPP
@@ -0,0 +1,278 @@
+// ==========================================================================
+// Dedmonwakeen's Raid DPS/TPS Simulator.
+// Send questions to natehieter@gmail.com
+// ==========================================================================
+
+#ifndef TDIGEST_HPP
+#define TDIGEST_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+/* Merging t-digest ( Dunning & Ertl, "Computing Extremely Accurate Quantiles Using t-Digests" )
+ *
+ * Summarizes a stream of values into a bounded number of weighted centroids, from which quantiles
+ * and the cumulative distribution can be estimated. Digests are mergeable, and the result only
+ * depends on the order of the added values and merged digests, which keeps multithreaded sims
+ * deterministic.
+ *
+ * Centroid sizes are bounded by the k1 scale function k( q ) = compression / ( 2 pi ) * asin( 2q - 1 ),
+ * each centroid spans at most one unit of k. The rank error of a quantile estimate is thus bounded
+ * by pi * sqrt( q( 1 - q ) ) / compression, for the default compression of 200 that is ~0.8% at
+ * the median and ~0.35% at the 5th/95th percentile. The digest keeps at most ~compression
+ * centroids, plus an insertion buffer of 4 * compression entries.
+ */
+class tdigest_t
+{
+public:
+  struct centroid_t
+  {
+    double mean;
+    double weight;
+
+    bool operator<( const centroid_t& other ) const
+    { return mean < other.mean; }
+
+    template <typename Archive>
+    void serialize( Archive& ar )
+    { ar( mean, weight ); }
+  };
+
+private:
+  double _compression;
+  double _total_weight;
+  double _min, _max;
+  std::vector<centroid_t> _centroids;
+  std::vector<centroid_t> _buffer;
+
+  static constexpr double pi = 3.14159265358979323846;
+
+  double k( double q ) const
+  { return _compression / ( 2.0 * pi ) * std::asin( 2.0 * q - 1.0 ); }
+
+  // k( q ) + 1 can be past k( 1 ), the angle is clamped to the range of asin so that sin does not
+  // wrap around, and the quantile to [ 0, 1 ]
+  double k_inverse( double k ) const
+  {
+    double angle = std::clamp( k * 2.0 * pi / _compression, -pi / 2.0, pi / 2.0 );
+    return std::clamp( ( std::sin( angle ) + 1.0 ) / 2.0, 0.0, 1.0 );
+  }
+
+  size_t buffer_size() const
+  { return static_cast<size_t>( 4 * _compression ); }
+
+public:
+  explicit tdigest_t( double compression = 200.0 ) :
+    _compression( compression ), _total_weight( 0 ),
+    _min( std::numeric_limits<double>::max() ), _max( std::numeric_limits<double>::lowest() )
+  { }
+
+  void add( double x, double w = 1.0 )
+  {
+    _buffer.push_back( { x, w } );
+    _min = std::min( _min, x );
+    _max = std::max( _max, x );
+
+    if ( _buffer.size() >= buffer_size() )
+    {
+      compress();
+    }
+  }
+
+  void merge( const tdigest_t& other )
+  {
+    if ( other.count() == 0 )
+    {
+      return;
+    }
+
+    _buffer.insert( _buffer.end(), other._centroids.begin(), other._centroids.end() );
+    _buffer.insert( _buffer.end(), other._buffer.begin(), other._buffer.end() );
+    _min = std::min( _min, other._min );
+    _max = std::max( _max, other._max );
+
+    compress();
+  }
+
+  // Merge buffered values into the centroids. Required before quantile() / cdf() are used.
+  void compress()
+  {
+    if ( _buffer.empty() )
+    {
+      return;
+    }
+
+    _buffer.insert( _buffer.end(), _centroids.begin(), _centroids.end() );
+    std::stable_sort( _buffer.begin(), _buffer.end() );
+
+    double total = 0;
+    for ( const auto& c : _buffer )
+    {
+      total += c.weight;
+    }
+
+    _centroids.clear();
+
+    double weight_so_far = 0;
+    double limit = total * k_inverse( k( 0 ) + 1 );
+    centroid_t current = _buffer.front();
+
+    for ( size_t i = 1; i < _buffer.size(); ++i )
+    {
+      const auto& next = _buffer[ i ];
+      double proposed = current.weight + next.weight;
+
+      if ( weight_so_far + proposed <= limit )
+      {
+        current.mean += ( next.mean - current.mean ) * next.weight / proposed;
+        current.weight = proposed;
+      }
+      else
+      {
+        weight_so_far += current.weight;
+        _centroids.push_back( current );
+        limit = total * k_inverse( k( weight_so_far / total ) + 1 );
+        current = next;
+      }
+    }
+
+    _centroids.push_back( current );
+    _total_weight = total;
+    _buffer.clear();
+  }
+
+  void clear()
+  {
+    _total_weight = 0;
+    _min = std::numeric_limits<double>::max();
+    _max = std::numeric_limits<double>::lowest();
+    _centroids.clear();
+    _buffer.clear();
+  }
+
+  bool compressed() const
+  { return _buffer.empty(); }
+
+  double count() const
+  {
+    double w = _total_weight;
+    for ( const auto& c : _buffer )
+    {
+      w += c.weight;
+    }
+    return w;
+  }
+
+  double min() const
+  { return _min; }
+
+  double max() const
+  { return _max; }
+
+  const std::vector<centroid_t>& centroids() const
+  { return _centroids; }
+
+  /* Estimate the value at quantile q ( 0 <= q <= 1 ). Values between centroid means are linearly
+   * interpolated, the tails are interpolated towards the exact minimum and maximum.
+   */
+  double quantile( double q ) const
+  {
+    assert( compressed() );
+    assert( q >= 0 && q <= 1.0 );
+
+    if ( _centroids.empty() )
+    {
+      return 0;
+    }
+
+    if ( _centroids.size() == 1 )
+    {
+      return _centroids.front().mean;
+    }
+
+    double index = q * _total_weight;
+    if ( index < _centroids.front().weight / 2.0 )
+    {
+      return _min + ( _centroids.front().mean - _min ) * 2.0 * index / _centroids.front().weight;
+    }
+
+    double weight_so_far = 0;
+    for ( size_t i = 0; i < _centroids.size() - 1; ++i )
+    {
+      const auto& left = _centroids[ i ];
+      const auto& right = _centroids[ i + 1 ];
+      double left_center = weight_so_far + left.weight / 2.0;
+      double right_center = weight_so_far + left.weight + right.weight / 2.0;
+
+      if ( index <= right_center )
+      {
+        double f = ( index - left_center ) / ( right_center - left_center );
+        return left.mean + f * ( right.mean - left.mean );
+      }
+
+      weight_so_far += left.weight;
+    }
+
+    const auto& last = _centroids.back();
+    double tail = _total_weight - index;
+    return _max - ( _max - last.mean ) * 2.0 * tail / last.weight;
+  }
+
+  /* Estimate the fraction of values less than or equal to x.
+   */
+  double cdf( double x ) const
+  {
+    assert( compressed() );
+
+    if ( _centroids.empty() || x < _min )
+    {
+      return 0;
+    }
+
+    if ( x >= _max )
+    {
+      return 1.0;
+    }
+
+    const auto& first = _centroids.front();
+    if ( x < first.mean )
+    {
+      double span = first.mean - _min;
+      double f = span > 0 ? ( x - _min ) / span : 1.0;
+      return f * first.weight / 2.0 / _total_weight;
+    }
+
+    double weight_so_far = 0;
+    for ( size_t i = 0; i < _centroids.size() - 1; ++i )
+    {
+      const auto& left = _centroids[ i ];
+      const auto& right = _centroids[ i + 1 ];
+
+      if ( x < right.mean )
+      {
+        double left_center = weight_so_far + left.weight / 2.0;
+        double right_center = weight_so_far + left.weight + right.weight / 2.0;
+        double span = right.mean - left.mean;
+        double f = span > 0 ? ( x - left.mean ) / span : 1.0;
+        return ( left_center + f * ( right_center - left_center ) ) / _total_weight;
+      }
+
+      weight_so_far += left.weight;
+    }
+
+    const auto& last = _centroids.back();
+    double span = _max - last.mean;
+    double f = span > 0 ? ( x - last.mean ) / span : 1.0;
+    double center = _total_weight - last.weight / 2.0;
+    return ( center + f * last.weight / 2.0 ) / _total_weight;
+  }
+
+  template <typename Archive>
+  void serialize( Archive& ar )
+  { ar( _compression, _total_weight, _min, _max, _centroids, _buffer ); }
+};
+
+#endif  // TDIGEST_HPP
@@ -149,6 +149,10 @@ public:
       _data.insert( _data.end(), other.data().begin() + _data.size(), other.data().end() );
   }
 
+  template <typename Archive>
+  void serialize( Archive& ar )
+  { ar( _data ); }
+
   void build_sliding_average_timeline( timeline_t& out, unsigned window ) const
   {
     out._data.reserve( data().size() );
@@ -239,11 +243,11 @@ public:
    */
   void create_histogram( const extended_sample_data_t& sd, size_t num_buckets, double min, double max )
   {
-    if ( sd.simple || sd.data().empty() )
+    if ( sd.simple || sd.size() == 0 )
       return;
     clear();
     _min = min; _max = max;
-    _data = statistics::create_histogram( sd.data(), num_buckets, _min, _max );
+    _data = sd.histogram( num_buckets, _min, _max );
     calculate_num_entries();
   }
 
@@ -251,8 +255,13 @@ public:
    */
   void create_histogram( const extended_sample_data_t& sd, size_t num_buckets )
   {
-    if ( sd.simple || sd.data().empty() )
+    if ( sd.simple || sd.size() == 0 )
+      return;
+    if ( sd.streaming() )
+    {
+      create_histogram( sd, num_buckets, sd.min(), sd.max() );
       return;
+    }
     double min = *std::min_element( sd.data().begin(), sd.data().end() );
     double max = *std::max_element( sd.data().begin(), sd.data().end() );
     create_histogram( sd, num_buckets, min, max );
@@ -8,12 +8,15 @@
 #include "config.hpp"
 #include "util/generic.hpp"
 
+#include <cstdint>
 #include <functional>
 #include <vector>
 
 /* Encapsulated Vector
  * const read access
- * Modifying the vector triggers registered callbacks
+ * Modifying the vector triggers registered callbacks, and increments the generation of the vector.
+ * Users that only need to know whether the vector changed (e.g., caches derived from it) should
+ * compare the generation instead of registering a callback.
  */
 template <typename T>
 struct vector_with_callback
@@ -38,6 +41,7 @@ public:
   void push_back( T x )
   {
     _data.push_back( std::move( x ) );
+    ++_generation;
     trigger_callbacks( _data.back() );
   }
 
@@ -63,11 +67,14 @@ public:
   bool empty() const
   { return _data.empty(); }
 
+  uint64_t generation() const
+  { return _generation; }
+
   void reset_callbacks()
   { _callbacks.clear(); }
 
   void clear_without_callbacks()
-  { _data.clear(); }
+  { _data.clear(); ++_generation; }
 
 private:
   void trigger_callbacks( const T& v ) const
@@ -84,10 +91,12 @@ private:
     {
       const T value = std::move( *it );
       erase( it );
+      ++_generation;
       trigger_callbacks( value );
     }
   }
 
   std::vector<T> _data;
   std::vector<callback_type> _callbacks;
+  uint64_t _generation = 0;
 };
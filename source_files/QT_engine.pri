@@ -58,6 +58,7 @@ HEADERS += engine/dbc/item_scaling.hpp
 HEADERS += engine/dbc/item_set_bonus.hpp
 HEADERS += engine/dbc/item_weapon.hpp
 HEADERS += engine/dbc/mastery_spells.hpp
+HEADERS += engine/dbc/name_index.hpp
 HEADERS += engine/dbc/permanent_enchant.hpp
 HEADERS += engine/dbc/racial_spells.hpp
 HEADERS += engine/dbc/rand_prop_points.hpp
@@ -143,12 +144,12 @@ HEADERS += engine/report/gear_weights.hpp
 HEADERS += engine/report/highchart.hpp
 HEADERS += engine/report/json/report_configuration.hpp
 HEADERS += engine/report/report_helper.hpp
-HEADERS += engine/report/report_timer.hpp
 HEADERS += engine/report/reports.hpp
 HEADERS += engine/sc_enums.hpp
 HEADERS += engine/sim/benefit.hpp
 HEADERS += engine/sim/cooldown.hpp
 HEADERS += engine/sim/cooldown_waste_data.hpp
+HEADERS += engine/sim/engine_profiler.hpp
 HEADERS += engine/sim/event.hpp
 HEADERS += engine/sim/event_manager.hpp
 HEADERS += engine/sim/expressions.hpp
@@ -167,6 +168,7 @@ HEADERS += engine/sim/shuffled_rng.hpp
 HEADERS += engine/sim/sim.hpp
 HEADERS += engine/sim/sim_control.hpp
 HEADERS += engine/sim/sim_ostream.hpp
+HEADERS += engine/sim/snapshot.hpp
 HEADERS += engine/sim/uptime.hpp
 HEADERS += engine/sim/work_queue.hpp
 HEADERS += engine/simulationcraft.hpp
@@ -178,8 +180,10 @@ HEADERS += engine/util/format.hpp
 HEADERS += engine/util/generic.hpp
 HEADERS += engine/util/git_info.hpp
 HEADERS += engine/util/io.hpp
+HEADERS += engine/util/name_registry.hpp
 HEADERS += engine/util/plot_data.hpp
 HEADERS += engine/util/resourcepaths.hpp
+HEADERS += engine/util/results_binary.hpp
 HEADERS += engine/util/rng.hpp
 HEADERS += engine/util/sample_data.hpp
 HEADERS += engine/util/sc_resourcepaths.hpp
@@ -188,6 +192,7 @@ HEADERS += engine/util/span.hpp
 HEADERS += engine/util/static_map.hpp
 HEADERS += engine/util/stopwatch.hpp
 HEADERS += engine/util/string_view.hpp
+HEADERS += engine/util/tdigest.hpp
 HEADERS += engine/util/timeline.hpp
 HEADERS += engine/util/timespan.hpp
 HEADERS += engine/util/util.hpp
@@ -334,10 +339,12 @@ SOURCES += engine/report/json/report_json.cpp
 SOURCES += engine/report/report_helper.cpp
 SOURCES += engine/report/report_html_player.cpp
 SOURCES += engine/report/report_html_sim.cpp
+SOURCES += engine/report/report_results_binary.cpp
 SOURCES += engine/report/report_text.cpp
 SOURCES += engine/report/reports.cpp
 SOURCES += engine/sim/cooldown.cpp
 SOURCES += engine/sim/cooldown_waste_data.cpp
+SOURCES += engine/sim/engine_profiler.cpp
 SOURCES += engine/sim/event.cpp
 SOURCES += engine/sim/event_manager.cpp
 SOURCES += engine/sim/expressions.cpp
@@ -354,12 +361,14 @@ SOURCES += engine/sim/scale_factor_control.cpp
 SOURCES += engine/sim/shuffled_rng.cpp
 SOURCES += engine/sim/sim.cpp
 SOURCES += engine/sim/sim_ostream.cpp
+SOURCES += engine/sim/snapshot.cpp
 SOURCES += engine/sim/uptime_benefit.cpp
 SOURCES += engine/util/cache.cpp
 SOURCES += engine/util/chrono.cpp
 SOURCES += engine/util/concurrency.cpp
 SOURCES += engine/util/git_info.cpp
 SOURCES += engine/util/io.cpp
+SOURCES += engine/util/results_binary.cpp
 SOURCES += engine/util/rng.cpp
 SOURCES += engine/util/timespan.cpp
 SOURCES += engine/util/util.cpp
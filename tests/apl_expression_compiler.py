@@ -0,0 +1,91 @@
+#!/usr/bin/env python3
+
+# APL expression compiler test. Simulates a profile deterministically with APL expressions evaluated
+# as expression trees and as compiled bytecode ( apl_expression_compiler=1 ), and checks that
+# - the actions performed in an iteration that uses compiled expressions, i.e. every APL decision,
+#   are the same
+# - the reported results are exactly the same
+
+import sys
+import re
+import os
+import argparse
+import tempfile
+import subprocess
+
+from helper import SIMC_CLI_PATH, SIMC_ITERATIONS, find_profiles, simulate_json, simulation_results, results_difference, check
+
+LOG_LINE_RE = re.compile(r'^\s*\d+\.\d+ .* performs ')
+
+# Expressions are only compiled once they are optimized ( optimize_expressions, 2 iterations by
+# default ), debug_each keeps the log of the last iteration
+LOG_ITERATIONS = 3
+
+# Statistics of the compiler, only reported when it is enabled
+COMPILER_STATISTICS = "apl_expressions"
+
+
+def combat_log(profile, path, options):
+    args = [ SIMC_CLI_PATH, profile, "debug_each=1", "iterations={}".format(LOG_ITERATIONS), "threads=1",
+             "deterministic=1", "output={}".format(path) ]
+    args.extend(options)
+    subprocess.run(args, check=True, stdout=subprocess.DEVNULL, stderr=subprocess.PIPE, encoding="UTF-8")
+    with open(path) as f:
+        return [ line.rstrip() for line in f if LOG_LINE_RE.match(line) ]
+
+
+def first_log_difference(a, b):
+    for i, (la, lb) in enumerate(zip(a, b)):
+        if la != lb:
+            return "line {}: {!r} != {!r}".format(i + 1, la, lb)
+    if len(a) != len(b):
+        return "{} != {} lines".format(len(a), len(b))
+    return None
+
+
+def results(report):
+    res = simulation_results(report)
+    res["statistics"].pop(COMPILER_STATISTICS, None)
+    return res
+
+
+parser = argparse.ArgumentParser(description="Run simc APL expression compiler tests.")
+parser.add_argument(
+    "specialization",
+    metavar="spec",
+    type=str,
+    help="Simc specialization in the form of CLASS_SPEC, eg. Priest_Shadow",
+)
+args = parser.parse_args()
+
+profiles = list(find_profiles(args.specialization))
+if len(profiles) == 0:
+    print("No profile found for {}".format(args.specialization))
+    sys.exit(1)
+
+failure = 0
+with tempfile.TemporaryDirectory() as output_dir:
+    for profile, path in profiles[:1]:
+        print(" {}".format(profile))
+
+        tree = combat_log(path, os.path.join(output_dir, "tree.log"), [ "apl_expression_compiler=0" ])
+        compiled = combat_log(path, os.path.join(output_dir, "compiled.log"), [ "apl_expression_compiler=1" ])
+        diff = first_log_difference(tree, compiled) if tree else "empty combat log"
+        if not check("actions performed with and without compiler", diff is None):
+            print("    {}".format(diff))
+            failure += 1
+
+        options = [ "iterations={}".format(SIMC_ITERATIONS), "threads=1", "deterministic=1" ]
+        tree = simulate_json(SIMC_CLI_PATH, path, os.path.join(output_dir, "tree.json"),
+                             options + [ "apl_expression_compiler=0" ])
+        compiled = simulate_json(SIMC_CLI_PATH, path, os.path.join(output_dir, "compiled.json"),
+                                 options + [ "apl_expression_compiler=1" ])
+        diff = results_difference(results(tree), results(compiled))
+        if not check("results with and without compiler", diff is None):
+            print("    {}".format(diff))
+            failure += 1
+
+        if not check("expressions compiled", compiled["sim"]["statistics"].get(COMPILER_STATISTICS, {}).get("compiled", 0) > 0):
+            failure += 1
+
+sys.exit(failure)
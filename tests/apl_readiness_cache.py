@@ -0,0 +1,90 @@
+#!/usr/bin/env python3
+
+# APL readiness cache test. Simulates a profile deterministically with and without reusing cached
+# APL condition results ( apl_readiness_cache=1 ), and checks that
+# - the actions performed in an iteration that uses the cache, i.e. every APL decision, are the same
+# - the reported results are exactly the same
+
+import sys
+import re
+import os
+import argparse
+import tempfile
+import subprocess
+
+from helper import SIMC_CLI_PATH, SIMC_ITERATIONS, find_profiles, simulate_json, simulation_results, results_difference, check
+
+LOG_LINE_RE = re.compile(r'^\s*\d+\.\d+ .* performs ')
+
+# Cached results are only used once expressions are optimized ( optimize_expressions, 2 iterations
+# by default ), debug_each keeps the log of the last iteration
+LOG_ITERATIONS = 3
+
+# Reuse statistics of the cache, only reported when it is enabled
+CACHE_STATISTICS = "apl_readiness_cache"
+
+
+def combat_log(profile, path, options):
+    args = [ SIMC_CLI_PATH, profile, "debug_each=1", "iterations={}".format(LOG_ITERATIONS), "threads=1",
+             "deterministic=1", "output={}".format(path) ]
+    args.extend(options)
+    subprocess.run(args, check=True, stdout=subprocess.DEVNULL, stderr=subprocess.PIPE, encoding="UTF-8")
+    with open(path) as f:
+        return [ line.rstrip() for line in f if LOG_LINE_RE.match(line) ]
+
+
+def first_log_difference(a, b):
+    for i, (la, lb) in enumerate(zip(a, b)):
+        if la != lb:
+            return "line {}: {!r} != {!r}".format(i + 1, la, lb)
+    if len(a) != len(b):
+        return "{} != {} lines".format(len(a), len(b))
+    return None
+
+
+def results(report):
+    res = simulation_results(report)
+    res["statistics"].pop(CACHE_STATISTICS, None)
+    return res
+
+
+parser = argparse.ArgumentParser(description="Run simc APL readiness cache tests.")
+parser.add_argument(
+    "specialization",
+    metavar="spec",
+    type=str,
+    help="Simc specialization in the form of CLASS_SPEC, eg. Priest_Shadow",
+)
+args = parser.parse_args()
+
+profiles = list(find_profiles(args.specialization))
+if len(profiles) == 0:
+    print("No profile found for {}".format(args.specialization))
+    sys.exit(1)
+
+failure = 0
+with tempfile.TemporaryDirectory() as output_dir:
+    for profile, path in profiles[:1]:
+        print(" {}".format(profile))
+
+        uncached = combat_log(path, os.path.join(output_dir, "uncached.log"), [ "apl_readiness_cache=0" ])
+        cached = combat_log(path, os.path.join(output_dir, "cached.log"), [ "apl_readiness_cache=1" ])
+        diff = first_log_difference(uncached, cached) if uncached else "empty combat log"
+        if not check("actions performed with and without cache", diff is None):
+            print("    {}".format(diff))
+            failure += 1
+
+        options = [ "iterations={}".format(SIMC_ITERATIONS), "threads=1", "deterministic=1" ]
+        uncached = simulate_json(SIMC_CLI_PATH, path, os.path.join(output_dir, "uncached.json"),
+                                 options + [ "apl_readiness_cache=0" ])
+        cached = simulate_json(SIMC_CLI_PATH, path, os.path.join(output_dir, "cached.json"),
+                               options + [ "apl_readiness_cache=1" ])
+        diff = results_difference(results(uncached), results(cached))
+        if not check("results with and without cache", diff is None):
+            print("    {}".format(diff))
+            failure += 1
+
+        if not check("cache reuses conditions", cached["sim"]["statistics"].get(CACHE_STATISTICS, {}).get("hits", 0) > 0):
+            failure += 1
+
+sys.exit(failure)
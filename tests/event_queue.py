@@ -0,0 +1,80 @@
+#!/usr/bin/env python3
+
+# Event queue test. Simulates a profile deterministically with each event queue implementation
+# ( event_queue=wheel|hierarchical|heap ), and checks that
+# - the actions performed in an iteration are the same
+# - the reported results are exactly the same
+# The queues only differ in how they store pending events, events of the same time are executed in
+# the order they were scheduled with every queue.
+
+import sys
+import re
+import os
+import argparse
+import tempfile
+import subprocess
+
+from helper import SIMC_CLI_PATH, SIMC_ITERATIONS, find_profiles, simulate_json, simulation_results, results_difference, check
+
+LOG_LINE_RE = re.compile(r'^\s*\d+\.\d+ .* performs ')
+
+QUEUES = ("wheel", "hierarchical", "heap")
+
+
+def combat_log(profile, path, options):
+    args = [ SIMC_CLI_PATH, profile, "log=1", "iterations=1", "threads=1", "deterministic=1",
+             "output={}".format(path) ]
+    args.extend(options)
+    subprocess.run(args, check=True, stdout=subprocess.DEVNULL, stderr=subprocess.PIPE, encoding="UTF-8")
+    with open(path) as f:
+        return [ line.rstrip() for line in f if LOG_LINE_RE.match(line) ]
+
+
+def first_log_difference(a, b):
+    for i, (la, lb) in enumerate(zip(a, b)):
+        if la != lb:
+            return "line {}: {!r} != {!r}".format(i + 1, la, lb)
+    if len(a) != len(b):
+        return "{} != {} lines".format(len(a), len(b))
+    return None
+
+
+parser = argparse.ArgumentParser(description="Run simc event queue tests.")
+parser.add_argument(
+    "specialization",
+    metavar="spec",
+    type=str,
+    help="Simc specialization in the form of CLASS_SPEC, eg. Priest_Shadow",
+)
+args = parser.parse_args()
+
+profiles = list(find_profiles(args.specialization))
+if len(profiles) == 0:
+    print("No profile found for {}".format(args.specialization))
+    sys.exit(1)
+
+failure = 0
+with tempfile.TemporaryDirectory() as output_dir:
+    for profile, path in profiles[:1]:
+        print(" {}".format(profile))
+
+        logs = { queue: combat_log(path, os.path.join(output_dir, "{}.log".format(queue)),
+                                   [ "event_queue={}".format(queue) ])
+                 for queue in QUEUES }
+        options = [ "iterations={}".format(SIMC_ITERATIONS), "threads=1", "deterministic=1" ]
+        reports = { queue: simulate_json(SIMC_CLI_PATH, path, os.path.join(output_dir, "{}.json".format(queue)),
+                                         options + [ "event_queue={}".format(queue) ])
+                    for queue in QUEUES }
+
+        for queue in QUEUES[1:]:
+            diff = first_log_difference(logs[QUEUES[0]], logs[queue]) if logs[queue] else "empty combat log"
+            if not check("actions performed with {} and {} queue".format(QUEUES[0], queue), diff is None):
+                print("    {}".format(diff))
+                failure += 1
+
+            diff = results_difference(simulation_results(reports[QUEUES[0]]), simulation_results(reports[queue]))
+            if not check("results with {} and {} queue".format(QUEUES[0], queue), diff is None):
+                print("    {}".format(diff))
+                failure += 1
+
+sys.exit(failure)
@@ -1,4 +1,5 @@
-import sys, os, shutil, subprocess, re, signal
+import sys, os, shutil, subprocess, re, signal, json, math
+from collections import OrderedDict
 from pathlib import Path
 
 def __error_status(code):
@@ -128,3 +129,50 @@ def run(tests):
     print('Passed: {}/{}'.format(success, total))
 
     return failure
+
+def simulate_json(simc_bin, profile, path, options):
+    """Simulates a profile with a JSON report written to path, returns the report"""
+    args = [ simc_bin, profile, 'json={}'.format(path) ]
+    args.extend(options)
+    subprocess.run(args, check=True, stdout=subprocess.DEVNULL, stderr=subprocess.PIPE, encoding='UTF-8')
+    with open(path) as f:
+        return json.load(f, object_pairs_hook=OrderedDict)
+
+def __is_timing(key):
+    return key.endswith('_seconds') or key.endswith('_per_second') or key == 'engine_profile'
+
+def simulation_results(report):
+    """The simulated results of a JSON report: the actors and the sim statistics, without timings"""
+    sim = report['sim']
+    statistics = OrderedDict((k, v) for k, v in sim['statistics'].items() if not __is_timing(k))
+    return OrderedDict([ ('players', sim['players']), ('targets', sim.get('targets')), ('statistics', statistics) ])
+
+def results_difference(a, b, rel_tol=0.0, path='$'):
+    """First difference between two JSON documents, numbers are compared with a relative tolerance"""
+    if isinstance(a, bool) or isinstance(b, bool) or not isinstance(a, (int, float)) or not isinstance(b, (int, float)):
+        if type(a) != type(b):
+            return '{} {!r} != {!r}'.format(path, a, b)
+    if isinstance(a, dict):
+        if list(a.keys()) != list(b.keys()):
+            return '{} members {} != {}'.format(path, list(a.keys()), list(b.keys()))
+        for k in a:
+            diff = results_difference(a[k], b[k], rel_tol, '{}.{}'.format(path, k))
+            if diff:
+                return diff
+    elif isinstance(a, list):
+        if len(a) != len(b):
+            return '{} length {} != {}'.format(path, len(a), len(b))
+        for i, (va, vb) in enumerate(zip(a, b)):
+            diff = results_difference(va, vb, rel_tol, '{}[{}]'.format(path, i))
+            if diff:
+                return diff
+    elif isinstance(a, (int, float)) and not isinstance(a, bool):
+        if not math.isclose(a, b, rel_tol=rel_tol, abs_tol=1e-9 if rel_tol else 0.0):
+            return '{} {!r} != {!r}'.format(path, a, b)
+    elif a != b:
+        return '{} {!r} != {!r}'.format(path, a, b)
+    return None
+
+def check(name, result):
+    print('  {:<60}    {}'.format(name, result and '[PASS]' or '[FAIL]'))
+    return result
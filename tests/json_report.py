@@ -0,0 +1,210 @@
+#!/usr/bin/env python3
+
+# JSON report conformance test. Simulates a profile with a compact and a pretty printed JSON report
+# and checks that
+# - both reports parse, and hold the same document
+# - both reports are byte for byte identical to the reports built as a single document before they
+#   are written ( json=...,document=1 ), the report writer before the report was streamed
+# - the report conforms to the report schema in engine/report/json/schema. The test is skipped
+#   ( exit code 77 ) if jsonschema is not installed, see tests/requirements.txt
+# - the report has the same members in the same order as the report of a reference simc binary
+#   ( --reference-simc ), e.g. a build from before a change to the JSON report writer. Values that
+#   differ between two runs ( timestamps, timings ) are not compared.
+
+import sys
+import os
+import re
+import json
+import argparse
+import tempfile
+import subprocess
+from collections import OrderedDict
+from pathlib import Path
+
+from helper import SIMC_CLI_PATH, SIMC_ITERATIONS, find_profiles
+
+SCHEMA_DIR = Path(__file__).resolve().parent.parent / "engine" / "report" / "json" / "schema"
+
+# Members whose values change from one run to the next
+VOLATILE_MEMBERS = ("timestamp", "build_date", "build_time", "git_revision", "git_branch", "version", "statistics")
+
+# Reports of the same run are written at different times
+TIMESTAMP_RE = re.compile(rb'"timestamp":\s*\d+')
+
+# Exit code of a skipped test, see SKIP_RETURN_CODE in tests/CMakeLists.txt
+SKIP_RETURN_CODE = 77
+
+
+def report_paths(output_dir, name):
+    return {
+        "compact": os.path.join(output_dir, name + ".json"),
+        "pretty": os.path.join(output_dir, name + "_pretty.json"),
+        "document": os.path.join(output_dir, name + "_document.json"),
+        "pretty_document": os.path.join(output_dir, name + "_pretty_document.json"),
+    }
+
+
+def simulate(simc_bin, profile, output_dir, name, document=False):
+    paths = report_paths(output_dir, name)
+    args = [
+        simc_bin,
+        profile,
+        "iterations={}".format(SIMC_ITERATIONS),
+        "threads=1",
+        "deterministic=1",
+        "json={}".format(paths["compact"]),
+        "json={},pretty_print=1".format(paths["pretty"]),
+    ]
+    if document:
+        args.extend([
+            "json={},document=1".format(paths["document"]),
+            "json={},pretty_print=1,document=1".format(paths["pretty_document"]),
+        ])
+    subprocess.run(args, check=True, stdout=subprocess.DEVNULL, stderr=subprocess.PIPE, encoding="UTF-8")
+
+    return load(paths["compact"]), load(paths["pretty"])
+
+
+def load(path):
+    with open(path) as f:
+        return json.load(f, object_pairs_hook=OrderedDict)
+
+
+def load_bytes(path):
+    with open(path, "rb") as f:
+        return TIMESTAMP_RE.sub(b'"timestamp":0', f.read())
+
+
+def first_byte_difference(a, b):
+    for i, (ca, cb) in enumerate(zip(a, b)):
+        if ca != cb:
+            return "byte {}: {!r} != {!r}".format(i, a[max(0, i - 40):i + 40], b[max(0, i - 40):i + 40])
+    if len(a) != len(b):
+        return "{} != {} bytes".format(len(a), len(b))
+    return None
+
+
+def schema_version(report_version):
+    # Pre-release versions ( 3.0.0-alpha1 ) are described by the schema of their release version
+    return report_version.split("-", 1)[0].split("+", 1)[0]
+
+
+def strip_volatile(report):
+    if isinstance(report, OrderedDict):
+        return OrderedDict((k, strip_volatile(v)) for k, v in report.items() if k not in VOLATILE_MEMBERS)
+    if isinstance(report, list):
+        return [strip_volatile(v) for v in report]
+    return report
+
+
+def first_difference(a, b, path="$"):
+    if type(a) != type(b):
+        return path
+    if isinstance(a, OrderedDict):
+        if list(a.keys()) != list(b.keys()):
+            return "{} members {} != {}".format(path, list(a.keys()), list(b.keys()))
+        for k in a:
+            diff = first_difference(a[k], b[k], "{}.{}".format(path, k))
+            if diff:
+                return diff
+    elif isinstance(a, list):
+        if len(a) != len(b):
+            return "{} length {} != {}".format(path, len(a), len(b))
+        for i, (va, vb) in enumerate(zip(a, b)):
+            diff = first_difference(va, vb, "{}[{}]".format(path, i))
+            if diff:
+                return diff
+    elif a != b:
+        return "{} {!r} != {!r}".format(path, a, b)
+    return None
+
+
+def validate_schema(jsonschema, report):
+    schema_file = SCHEMA_DIR / "{}.schema.json".format(schema_version(report["report_version"]))
+    if not schema_file.exists():
+        print("  No schema {} for report version {}".format(schema_file.name, report["report_version"]))
+        return False
+
+    with open(schema_file) as f:
+        schema = json.load(f)
+
+    expected_id = "https://www.simulationcraft.org/reports/{}.schema.json".format(report["report_version"])
+    if report.get("$id") != expected_id:
+        print("  Report $id {} does not match {}".format(report.get("$id"), expected_id))
+        return False
+
+    try:
+        jsonschema.validate(report, schema)
+    except jsonschema.ValidationError as err:
+        print("  Report does not conform to {}: {}".format(schema_file.name, err.message))
+        return False
+
+    return True
+
+
+def check(name, result):
+    print("  {:<60}    {}".format(name, result and "[PASS]" or "[FAIL]"))
+    return result
+
+
+parser = argparse.ArgumentParser(description="Run simc JSON report conformance tests.")
+parser.add_argument(
+    "specialization",
+    metavar="spec",
+    type=str,
+    help="Simc specialization in the form of CLASS_SPEC, eg. Priest_Shadow",
+)
+parser.add_argument(
+    "--reference-simc",
+    type=str,
+    help="simc binary whose JSON report the report is compared against",
+)
+args = parser.parse_args()
+
+profiles = list(find_profiles(args.specialization))
+if len(profiles) == 0:
+    print("No profile found for {}".format(args.specialization))
+    sys.exit(1)
+
+try:
+    import jsonschema
+except ImportError:
+    jsonschema = None
+
+failure = 0
+skipped = False
+with tempfile.TemporaryDirectory() as output_dir:
+    for profile, path in profiles[:1]:
+        print(" {}".format(profile))
+        compact, pretty = simulate(SIMC_CLI_PATH, path, output_dir, "report", document=True)
+
+        diff = first_difference(compact, pretty)
+        if not check("compact and pretty printed reports", diff is None):
+            print("    {}".format(diff))
+            failure += 1
+
+        paths = report_paths(output_dir, "report")
+        for streamed, document in (("compact", "document"), ("pretty", "pretty_document")):
+            diff = first_byte_difference(load_bytes(paths[document]), load_bytes(paths[streamed]))
+            if not check("{} report and single document report".format(streamed), diff is None):
+                print("    {}".format(diff))
+                failure += 1
+
+        if jsonschema is None:
+            print("  {:<60}    [SKIP]".format("report schema"))
+            print("    jsonschema is not installed, install tests/requirements.txt")
+            skipped = True
+        elif not check("report schema", validate_schema(jsonschema, compact)):
+            failure += 1
+
+        if args.reference_simc:
+            reference, _ = simulate(args.reference_simc, path, output_dir, "reference")
+            diff = first_difference(strip_volatile(reference), strip_volatile(compact))
+            if not check("reference report", diff is None):
+                print("    {}".format(diff))
+                failure += 1
+
+if failure == 0 and skipped:
+    sys.exit(SKIP_RETURN_CODE)
+
+sys.exit(failure)
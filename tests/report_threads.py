@@ -0,0 +1,113 @@
+#!/usr/bin/env python3
+
+# Report threading test. Simulates the profiles of a specialization once with a result snapshot
+# ( snapshot=<file> ), and writes the text and html reports of the snapshot ( merge=<file> ) with one
+# and with several threads. The html report renders the player sections concurrently with several
+# threads, and checks that both reports are byte for byte identical to the reports written by a
+# single thread. Values that differ between two runs ( timestamps, timings ) and the thread count are
+# not compared.
+
+import sys
+import os
+import re
+import argparse
+import tempfile
+import subprocess
+
+from helper import SIMC_CLI_PATH, SIMC_ITERATIONS, find_profiles
+
+THREADS = 4
+
+# Profiles reported together, every player is a section of its own
+MAX_PROFILES = 3
+
+# Text report: the performance summary is made of timings, the compiled APL statistics hold a
+# selection timing
+TEXT_VOLATILE_RE = [
+    re.compile(rb'\n\nBaseline Performance:\n.*?\n\n', re.S),
+    re.compile(rb' \([\d.]+us/selection\)'),
+]
+
+# Html report: generation time, timings and the thread count of the sim information
+HTML_VOLATILE_RE = [
+    re.compile(rb'<li><b>Timestamp:</b>[^<]*</li>'),
+    re.compile(rb'(<th>(?:Threads|CPU Seconds|Physical Seconds|Speed Up):</th>\s*<td>)[^<]*'),
+]
+
+
+def report_paths(output_dir, name):
+    return {
+        "text": os.path.join(output_dir, name + ".txt"),
+        "html": os.path.join(output_dir, name + ".html"),
+    }
+
+
+def write_reports(paths, snapshot, output_dir, name, threads):
+    reports = report_paths(output_dir, name)
+    args = [ SIMC_CLI_PATH ]
+    args.extend(paths)
+    args.extend([ "merge={}".format(snapshot), "threads={}".format(threads),
+                  "output={}".format(reports["text"]), "html={}".format(reports["html"]) ])
+    subprocess.run(args, check=True, stdout=subprocess.DEVNULL, stderr=subprocess.PIPE, encoding="UTF-8")
+    return { kind: load_bytes(path, TEXT_VOLATILE_RE if kind == "text" else HTML_VOLATILE_RE)
+             for kind, path in reports.items() }
+
+
+def load_bytes(path, volatile):
+    with open(path, "rb") as f:
+        data = f.read()
+    for expr in volatile:
+        data = expr.sub(lambda m: m.group(1) if m.re.groups else b'', data)
+    return data
+
+
+def first_byte_difference(a, b):
+    for i, (ca, cb) in enumerate(zip(a, b)):
+        if ca != cb:
+            return "byte {}: {!r} != {!r}".format(i, a[max(0, i - 40):i + 40], b[max(0, i - 40):i + 40])
+    if len(a) != len(b):
+        return "{} != {} bytes".format(len(a), len(b))
+    return None
+
+
+def check(name, result):
+    print("  {:<60}    {}".format(name, result and "[PASS]" or "[FAIL]"))
+    return result
+
+
+parser = argparse.ArgumentParser(description="Run simc report threading tests.")
+parser.add_argument(
+    "specialization",
+    metavar="spec",
+    type=str,
+    help="Simc specialization in the form of CLASS_SPEC, eg. Priest_Shadow",
+)
+args = parser.parse_args()
+
+profiles = list(find_profiles(args.specialization))
+if len(profiles) == 0:
+    print("No profile found for {}".format(args.specialization))
+    sys.exit(1)
+
+failure = 0
+with tempfile.TemporaryDirectory() as output_dir:
+    profiles = profiles[:MAX_PROFILES]
+    print(" {}".format(", ".join(profile for profile, _ in profiles)))
+    paths = [ path for _, path in profiles ]
+
+    snapshot = os.path.join(output_dir, "results.snapshot")
+    args = [ SIMC_CLI_PATH ]
+    args.extend(paths)
+    args.extend([ "iterations={}".format(SIMC_ITERATIONS), "threads={}".format(THREADS), "deterministic=1",
+                  "snapshot={}".format(snapshot) ])
+    subprocess.run(args, check=True, stdout=subprocess.DEVNULL, stderr=subprocess.PIPE, encoding="UTF-8")
+
+    serial = write_reports(paths, snapshot, output_dir, "serial", 1)
+    threaded = write_reports(paths, snapshot, output_dir, "threaded", THREADS)
+    for kind in ("text", "html"):
+        diff = first_byte_difference(serial[kind], threaded[kind])
+        if not check("{} report with 1 and {} threads".format(kind, THREADS), diff is None):
+            print("    {}".format(diff))
+            failure += 1
+
+sys.exit(failure)
@@ -0,0 +1,232 @@
+#!/usr/bin/env python3
+
+# Binary results test. Simulates a profile with a JSON report and a binary results file
+# ( results_binary=<file> ), reads the file back with the C++ reader ( results_binary::reader_t,
+# through the results_binary_reader test program ) and with util_scripts/read_results_binary.py, and
+# checks that
+# - both readers return the same columns
+# - the columns hold the per-iteration samples of the collected data: row count, sum, minimum and
+#   maximum of each column equal those of the sample data in the JSON report
+# - truncated files are rejected by both readers
+#
+# The python reader needs numpy ( tests/requirements.txt ), without it the test is skipped
+# ( exit code 77 ).
+
+import sys
+import os
+import math
+import json
+import argparse
+import tempfile
+import subprocess
+from pathlib import Path
+
+from helper import SIMC_CLI_PATH, SIMC_ITERATIONS, find_profiles, check
+
+sys.path.insert(0, str(Path(__file__).resolve().parent.parent / "util_scripts"))
+try:
+    import read_results_binary
+except ImportError:
+    read_results_binary = None
+
+# Exit code of a skipped test, see SKIP_RETURN_CODE in tests/CMakeLists.txt
+SKIP_RETURN_CODE = 77
+
+REL_TOL = 1e-9
+
+# Columns of an actor and the collected data member holding the same samples in the JSON report
+COLLECTED_DATA_KEYS = {
+    "fight_length": "fight_length",
+    "dmg": "dmg",
+    "compound_dmg": "compound_dmg",
+    "prioritydps": "prioritydps",
+    "dps": "dps",
+    "dpse": "dpse",
+    "heal": "heal",
+    "compound_heal": "compound_heal",
+    "hps": "hps",
+    "absorb": "absorb",
+    "aps": "aps",
+    "dmg_taken": "dtps",
+    "theck_meloree_index": "theck_meloree_index",
+    "effective_theck_meloree_index": "effective_theck_meloree_index",
+    "max_spike_amount": "max_spike_amount",
+    "death_time": "deaths",
+}
+
+# Sim-scope columns and their member in the statistics of the JSON report
+STATISTICS_KEYS = ("raid_dps", "simulation_length")
+
+
+def simulate(profile, output_dir):
+    results = os.path.join(output_dir, "results.bin")
+    report = os.path.join(output_dir, "report.json")
+    args = [
+        SIMC_CLI_PATH,
+        profile,
+        "iterations={}".format(SIMC_ITERATIONS),
+        "threads=1",
+        "deterministic=1",
+        "results_binary={}".format(results),
+        "json={}".format(report),
+    ]
+    subprocess.run(args, check=True, stdout=subprocess.DEVNULL, stderr=subprocess.PIPE, encoding="UTF-8")
+
+    with open(report) as f:
+        return results, json.load(f)
+
+
+def read_cpp(reader, path):
+    """Iteration count and (actor, metric) -> (rows, sum, min, max, first, last) of the C++ reader, None if
+    the file is rejected"""
+    res = subprocess.run([reader, path], stdout=subprocess.PIPE, stderr=subprocess.PIPE, encoding="UTF-8")
+    if res.returncode != 0:
+        return None
+
+    lines = res.stdout.splitlines()
+    iterations = int(lines[0].split("\t")[1])
+    columns = {}
+    for line in lines[1:]:
+        actor, metric, rows, *values = line.split("\t")
+        columns[(actor, metric)] = tuple([int(rows)] + [float(v) for v in values])
+
+    return iterations, columns
+
+
+def summary(rows):
+    """Same summary as the C++ reader, summed in row order"""
+    if len(rows) == 0:
+        return (0, 0.0, 0.0, 0.0, 0.0, 0.0)
+    values = rows.tolist()
+    return (len(values), sum(values), min(values), max(values), values[0], values[-1])
+
+
+def read_python(path):
+    try:
+        iterations, columns = read_results_binary.read_results(path)
+    except ValueError:
+        return None
+    return iterations, { key: summary(rows) for key, rows in columns.items() }
+
+
+def compare_sample_data(name, column, data):
+    """Difference between a column summary and the sample data of the JSON report, None if equal"""
+    if column is None:
+        # Empty sample data has no column
+        return None if data.get("count", 0) == 0 else "{}: no column".format(name)
+
+    rows, total, minimum, maximum = column[:4]
+    if rows != data["count"]:
+        return "{}: {} rows, count {}".format(name, rows, data["count"])
+    if rows > 0 and (minimum != data["min"] or maximum != data["max"]):
+        return "{}: min/max {}/{}, expected {}/{}".format(name, minimum, maximum, data["min"], data["max"])
+    if not math.isclose(total, data["sum"], rel_tol=REL_TOL):
+        return "{}: sum {}, expected {}".format(name, total, data["sum"])
+    return None
+
+
+def compare_report(iterations, columns, report):
+    sim = report["sim"]
+    statistics = sim["statistics"]
+    if iterations != statistics["simulation_length"]["count"]:
+        return ["iterations {}, expected {}".format(iterations, statistics["simulation_length"]["count"])], 0
+
+    differences = []
+    compared = 0
+    for key in STATISTICS_KEYS:
+        if key in statistics:
+            diff = compare_sample_data("sim " + key, columns.get(("", key)), statistics[key])
+            compared += 1
+            if diff:
+                differences.append(diff)
+
+    for player in sim["players"]:
+        collected_data = player["collected_data"]
+        for metric, key in COLLECTED_DATA_KEYS.items():
+            if key not in collected_data:
+                continue
+            diff = compare_sample_data("{} {}".format(player["name"], metric),
+                                       columns.get((player["name"], metric)), collected_data[key])
+            compared += 1
+            if diff:
+                differences.append(diff)
+
+    return differences, compared
+
+
+def truncate(path, size, output_dir, name):
+    truncated = os.path.join(output_dir, name)
+    with open(path, "rb") as f:
+        data = f.read()
+    with open(truncated, "wb") as f:
+        f.write(data[:size])
+    return truncated
+
+
+parser = argparse.ArgumentParser(description="Run simc binary results tests.")
+parser.add_argument(
+    "specialization",
+    metavar="spec",
+    type=str,
+    help="Simc specialization in the form of CLASS_SPEC, eg. Priest_Shadow",
+)
+args = parser.parse_args()
+
+reader = os.environ.get("RESULTS_BINARY_READER")
+if reader is None:
+    print("No RESULTS_BINARY_READER environment variable set")
+    sys.exit(1)
+
+profiles = list(find_profiles(args.specialization))
+if len(profiles) == 0:
+    print("No profile found for {}".format(args.specialization))
+    sys.exit(1)
+
+failure = 0
+skipped = False
+with tempfile.TemporaryDirectory() as output_dir:
+    for profile, path in profiles[:1]:
+        print(" {}".format(profile))
+        results, report = simulate(path, output_dir)
+
+        cpp = read_cpp(reader, results)
+        if not check("C++ reader accepts the file", cpp is not None):
+            failure += 1
+            continue
+
+        differences, compared = compare_report(*cpp, report)
+        if not check("columns equal the collected data of the JSON report", not differences and compared > 0):
+            print("    {} sample data compared".format(compared))
+            for diff in differences[:10]:
+                print("    {}".format(diff))
+            failure += 1
+
+        # The last column ends the file, the 32 byte header is followed by the directory
+        size = os.path.getsize(results)
+        truncated = [ truncate(results, size - 8, output_dir, "truncated_column.bin"),
+                      truncate(results, 40, output_dir, "truncated_directory.bin"),
+                      truncate(results, 4, output_dir, "truncated_header.bin") ]
+        if not check("C++ reader rejects truncated files", all(read_cpp(reader, t) is None for t in truncated)):
+            failure += 1
+
+        if read_results_binary is None:
+            print("  {:<60}    [SKIP]".format("python reader"))
+            print("    numpy is not installed, install tests/requirements.txt")
+            skipped = True
+            continue
+
+        py = read_python(results)
+        if not check("python reader matches the C++ reader", py == cpp):
+            if py is None:
+                print("    python reader rejected the file")
+            else:
+                print("    {}".format(sorted(set(py[1].items()) ^ set(cpp[1].items()))[:5]))
+            failure += 1
+
+        if not check("python reader rejects truncated files", all(read_python(t) is None for t in truncated)):
+            failure += 1
+
+if failure == 0 and skipped:
+    sys.exit(SKIP_RETURN_CODE)
+
+sys.exit(failure)
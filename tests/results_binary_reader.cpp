@@ -0,0 +1,59 @@
+// ==========================================================================
+// Dedmonwakeen's Raid DPS/TPS Simulator.
+// Send questions to natehieter@gmail.com
+// ==========================================================================
+
+// Reads a results file ( results_binary=<file> ) with results_binary::reader_t and prints the
+// iteration count and a summary of every column, tab separated:
+//
+//   iterations <count>
+//   <actor> <metric> <row count> <sum> <min> <max> <first row> <last row>
+//
+// Used by tests/results_binary.py to compare the file with the JSON report and the python reader.
+// Exits with 1 if the file is rejected.
+
+#include "util/results_binary.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <exception>
+#include <string>
+
+int main( int argc, char** argv )
+{
+  if ( argc < 2 )
+  {
+    std::fprintf( stderr, "Usage: results_binary_reader <results file>\n" );
+    return 2;
+  }
+
+  try
+  {
+    auto reader = results_binary::reader_t::open( argv[ 1 ] );
+
+    std::printf( "iterations\t%llu\n", static_cast<unsigned long long>( reader->iterations() ) );
+    for ( size_t i = 0; i < reader->column_count(); ++i )
+    {
+      auto column = reader->column( i );
+      double sum = 0.0;
+      for ( double v : column.rows )
+        sum += v;
+
+      double min = column.rows.empty() ? 0.0 : *std::min_element( column.rows.begin(), column.rows.end() );
+      double max = column.rows.empty() ? 0.0 : *std::max_element( column.rows.begin(), column.rows.end() );
+      double first = column.rows.empty() ? 0.0 : column.rows.front();
+      double last = column.rows.empty() ? 0.0 : column.rows.back();
+
+      std::printf( "%s\t%s\t%u\t%.17g\t%.17g\t%.17g\t%.17g\t%.17g\n", std::string( column.actor ).c_str(),
+                   std::string( column.metric ).c_str(), static_cast<unsigned>( column.rows.size() ), sum, min, max,
+                   first, last );
+    }
+  }
+  catch ( const std::exception& e )
+  {
+    std::fprintf( stderr, "%s\n", e.what() );
+    return 1;
+  }
+
+  return 0;
+}
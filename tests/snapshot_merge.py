@@ -0,0 +1,100 @@
+#!/usr/bin/env python3
+
+# Snapshot merge test. Simulates a profile deterministically on two threads, and the same iterations
+# as two single thread runs with a result snapshot each ( snapshot=<file> ): thread 1 of the threaded
+# run uses the random numbers of a single thread run with the next seed. Checks that
+# - the report of the two merged snapshots ( merge=<file>,<file> ) has the collected data, pet stats
+#   and lowest and highest iterations of the threaded run, which merges its threads in process.
+#   Profiles of pet classes check the dynamically spawned pets, which are merged through their spawner
+# - a snapshot is not merged twice ( same seed )
+# - snapshots are not merged into a sim with other profile options
+# Merging only changes the order of floating point additions, so numbers are compared with a small
+# relative tolerance.
+
+import sys
+import os
+import argparse
+import tempfile
+import subprocess
+
+from helper import SIMC_CLI_PATH, SIMC_ITERATIONS, find_profiles, simulate_json, results_difference, check
+
+REL_TOL = 1e-9
+
+SEED = 31459
+
+# Collected data of a single iteration, which snapshots do not hold
+SINGLE_ITERATION_KEYS = ("buffed_stats",)
+
+
+def collected_data(report):
+    sim = report["sim"]
+    return [ (player["name"], { k: v for k, v in player["collected_data"].items() if k not in SINGLE_ITERATION_KEYS },
+              player.get("stats_pets"))
+             for player in sim["players"] + sim.get("targets", []) ]
+
+
+def iteration_data(report):
+    return report["sim"].get("iteration_data")
+
+
+def merge_fails(profile, output_dir, snapshots, options=[]):
+    args = [ SIMC_CLI_PATH, profile, "merge={}".format(",".join(snapshots)),
+             "json={}".format(os.path.join(output_dir, "rejected.json")) ]
+    args.extend(options)
+    res = subprocess.run(args, stdout=subprocess.DEVNULL, stderr=subprocess.PIPE, encoding="UTF-8")
+    return res.returncode != 0
+
+
+parser = argparse.ArgumentParser(description="Run simc snapshot merge tests.")
+parser.add_argument(
+    "specialization",
+    metavar="spec",
+    type=str,
+    help="Simc specialization in the form of CLASS_SPEC, eg. Priest_Shadow",
+)
+args = parser.parse_args()
+
+profiles = list(find_profiles(args.specialization))
+if len(profiles) == 0:
+    print("No profile found for {}".format(args.specialization))
+    sys.exit(1)
+
+failure = 0
+with tempfile.TemporaryDirectory() as output_dir:
+    for profile, path in profiles[:1]:
+        print(" {}".format(profile))
+        iterations = max(SIMC_ITERATIONS, 4)
+        threaded = simulate_json(SIMC_CLI_PATH, path, os.path.join(output_dir, "threaded.json"),
+                                 [ "iterations={}".format(2 * iterations), "threads=2", "deterministic=1",
+                                   "seed={}".format(SEED) ])
+
+        snapshots = []
+        for thread in range(2):
+            snapshot = os.path.join(output_dir, "thread{}.snapshot".format(thread))
+            simulate_json(SIMC_CLI_PATH, path, os.path.join(output_dir, "thread{}.json".format(thread)),
+                          [ "iterations={}".format(iterations), "threads=1", "deterministic=1",
+                            "seed={}".format(SEED + thread), "snapshot={}".format(snapshot) ])
+            snapshots.append(snapshot)
+
+        merged = simulate_json(SIMC_CLI_PATH, path, os.path.join(output_dir, "merged.json"),
+                               [ "merge={}".format(",".join(snapshots)) ])
+
+        diff = results_difference(collected_data(threaded), collected_data(merged), REL_TOL)
+        if not check("merged snapshots and in process thread merge", diff is None):
+            print("    {}".format(diff))
+            failure += 1
+
+        diff = results_difference(iteration_data(threaded), iteration_data(merged), REL_TOL)
+        if not check("merged snapshots and in process thread merge iteration data", diff is None):
+            print("    {}".format(diff))
+            failure += 1
+
+        if not check("snapshot of the same seed rejected", merge_fails(path, output_dir, [ snapshots[0] ] * 2)):
+            failure += 1
+
+        if not check("snapshot of other profile options rejected",
+                     merge_fails(path, output_dir, snapshots, [ "max_time=123" ])):
+            failure += 1
+
+sys.exit(failure)
@@ -0,0 +1,149 @@
+// ==========================================================================
+// Dedmonwakeen's Raid DPS/TPS Simulator.
+// Send questions to natehieter@gmail.com
+// ==========================================================================
+
+// t-digest accuracy test. Quantile and cdf estimates of digests built from uniform, normal and
+// exponential samples are checked against the exact ranks of the sorted samples, for a single
+// digest and for digests merged from several parts the way thread child sims merge theirs. The
+// allowed rank error is the bound documented in util/tdigest.hpp.
+
+#include "util/tdigest.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace
+{
+constexpr double COMPRESSION = 200.0;
+constexpr double QUANTILES[] = { 0.001, 0.01, 0.05, 0.1, 0.25, 0.5, 0.75, 0.9, 0.95, 0.99, 0.999 };
+constexpr double pi = 3.14159265358979323846;
+
+// Deterministic uniform numbers in ( 0, 1 )
+struct lcg_t
+{
+  uint64_t state = 0x853c49e6748fea9bULL;
+
+  double operator()()
+  {
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return ( ( state >> 11 ) + 0.5 ) / 9007199254740992.0;
+  }
+};
+
+std::vector<double> samples( const std::function<double( lcg_t& )>& dist, size_t n )
+{
+  lcg_t rng;
+  std::vector<double> values( n );
+  for ( auto& v : values )
+    v = dist( rng );
+  return values;
+}
+
+double rank_error_bound( double q, size_t n )
+{ return pi * std::sqrt( q * ( 1 - q ) ) / COMPRESSION + 1.0 / n; }
+
+// Fraction of samples less than or equal to x
+double exact_rank( const std::vector<double>& sorted, double x )
+{ return double( std::upper_bound( sorted.begin(), sorted.end(), x ) - sorted.begin() ) / sorted.size(); }
+
+bool check( const std::string& name, bool result )
+{
+  std::printf( "  %-60s    %s\n", name.c_str(), result ? "[PASS]" : "[FAIL]" );
+  return result;
+}
+
+int check_digest( const std::string& name, const tdigest_t& digest, std::vector<double> values )
+{
+  std::sort( values.begin(), values.end() );
+  int failure = 0;
+
+  if ( !check( name + " count, min and max",
+               digest.count() == values.size() && digest.min() == values.front() && digest.max() == values.back() ) )
+  {
+    ++failure;
+  }
+
+  for ( double q : QUANTILES )
+  {
+    double estimate = digest.quantile( q );
+    // Any value between the exact quantiles q - e and q + e has a rank error below e
+    double rank = exact_rank( values, estimate );
+    double bound = rank_error_bound( q, values.size() );
+    if ( !check( name + " quantile " + std::to_string( q ), std::abs( rank - q ) <= bound ) )
+    {
+      std::printf( "    estimate %f has rank %f, allowed %f +- %f\n", estimate, rank, q, bound );
+      ++failure;
+    }
+
+    double exact = values[ std::min( values.size() - 1, size_t( q * values.size() ) ) ];
+    double cdf = digest.cdf( exact );
+    if ( !check( name + " cdf " + std::to_string( q ), std::abs( cdf - exact_rank( values, exact ) ) <= bound ) )
+    {
+      std::printf( "    cdf %f of exact quantile %f, allowed %f +- %f\n", cdf, exact, exact_rank( values, exact ),
+                   bound );
+      ++failure;
+    }
+  }
+
+  if ( !check( name + " centroid count", digest.centroids().size() <= 2 * COMPRESSION ) )
+  {
+    std::printf( "    %u centroids\n", unsigned( digest.centroids().size() ) );
+    ++failure;
+  }
+
+  return failure;
+}
+
+int test_distribution( const std::string& name, const std::function<double( lcg_t& )>& dist )
+{
+  constexpr size_t n = 100000;
+  auto values = samples( dist, n );
+  int failure = 0;
+
+  std::printf( " %s\n", name.c_str() );
+
+  tdigest_t single( COMPRESSION );
+  for ( double v : values )
+    single.add( v );
+  single.compress();
+  failure += check_digest( "single", single, values );
+
+  // Parts of unequal size, merged pairwise in a tree like the thread children of a sim
+  for ( size_t parts : { 2u, 7u, 32u } )
+  {
+    std::vector<tdigest_t> digests( parts, tdigest_t( COMPRESSION ) );
+    for ( size_t i = 0; i < n; ++i )
+      digests[ ( i * i ) % parts ].add( values[ i ] );
+
+    for ( size_t stride = 1; stride < parts; stride *= 2 )
+    {
+      for ( size_t i = 0; i + stride < parts; i += 2 * stride )
+        digests[ i ].merge( digests[ i + stride ] );
+    }
+    digests[ 0 ].compress();
+
+    failure += check_digest( "merged from " + std::to_string( parts ), digests[ 0 ], values );
+  }
+
+  return failure;
+}
+}  // unnamed namespace
+
+int main()
+{
+  int failure = 0;
+
+  failure += test_distribution( "uniform", []( lcg_t& rng ) { return 1000.0 * rng(); } );
+  failure += test_distribution( "normal", []( lcg_t& rng ) {
+    return 50000.0 + 5000.0 * std::sqrt( -2.0 * std::log( rng() ) ) * std::cos( 2.0 * pi * rng() );
+  } );
+  failure += test_distribution( "exponential", []( lcg_t& rng ) { return -100.0 * std::log( rng() ); } );
+
+  std::printf( "Failed: %d\n", failure );
+
+  return failure != 0;
+}
@@ -0,0 +1,51 @@
+#!/usr/bin/env python3
+
+# Thread merge test. Simulates a profile deterministically on several threads, once with the thread
+# children merged in a tree ( the default ) and once merged in thread order by thread 0
+# ( merge_tree=0 ), and checks that the reported results are the same. The merge order only changes
+# the order of floating point additions, so the tree merge is not bitwise identical to the serial
+# merge: numbers are compared with a small relative tolerance.
+
+import sys
+import argparse
+import tempfile
+import os
+
+from helper import SIMC_CLI_PATH, SIMC_ITERATIONS, find_profiles, simulate_json, simulation_results, results_difference, check
+
+REL_TOL = 1e-9
+
+parser = argparse.ArgumentParser(description="Run simc thread merge order tests.")
+parser.add_argument(
+    "specialization",
+    metavar="spec",
+    type=str,
+    help="Simc specialization in the form of CLASS_SPEC, eg. Priest_Shadow",
+)
+parser.add_argument("--threads", type=int, default=8, help="Number of threads to simulate on")
+args = parser.parse_args()
+
+profiles = list(find_profiles(args.specialization))
+if len(profiles) == 0:
+    print("No profile found for {}".format(args.specialization))
+    sys.exit(1)
+
+failure = 0
+with tempfile.TemporaryDirectory() as output_dir:
+    for profile, path in profiles[:1]:
+        print(" {}".format(profile))
+        options = [
+            "iterations={}".format(max(SIMC_ITERATIONS, 4 * args.threads)),
+            "threads={}".format(args.threads),
+            "deterministic=1",
+        ]
+        tree = simulate_json(SIMC_CLI_PATH, path, os.path.join(output_dir, "tree.json"), options)
+        ordered = simulate_json(SIMC_CLI_PATH, path, os.path.join(output_dir, "ordered.json"),
+                                options + [ "merge_tree=0" ])
+
+        diff = results_difference(simulation_results(ordered), simulation_results(tree), REL_TOL)
+        if not check("threads={} tree merge and thread order merge".format(args.threads), diff is None):
+            print("    {}".format(diff))
+            failure += 1
+
+sys.exit(failure)
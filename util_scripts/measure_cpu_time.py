@@ -7,11 +7,13 @@ import numpy as np
 import json
 
 
+# Usage: measure_cpu_time.py [profile.simc] [extra options], e.g.
+#   measure_cpu_time.py ../profiles/DS_Dungeon.simc "deterministic=1 fight_style=DungeonSlice"
 def main():
     simc_bin = "../engine/simc"
     name = "T22_Raid"
-    profile = name + ".simc"
-    extra_options = "deterministic=1"
+    profile = sys.argv[1] if len(sys.argv) > 1 else name + ".simc"
+    extra_options = sys.argv[2] if len(sys.argv) > 2 else "deterministic=1"
     threads = 1
     output_dir = "/tmp"
 
@@ -20,8 +22,8 @@ def main():
     list_cpu_seconds = []
 
     for repetition in range(num_repetitions):
-        json_file = output_dir + profile + ".json"
-        command = "{bin} {profile} {eo} iterations={iterations} threads={threads} output={output} json={json}".format(bin=simc_bin, profile=profile, eo=extra_options, iterations=iterations, threads=threads, output=output_dir + profile + ".txt", json=json_file)
+        json_file = output_dir + "/measure_cpu_time.json"
+        command = "{bin} {profile} {eo} iterations={iterations} threads={threads} output={output} json={json}".format(bin=simc_bin, profile=profile, eo=extra_options, iterations=iterations, threads=threads, output=output_dir + "/measure_cpu_time.txt", json=json_file)
         command = command.split(" ")
         print("Calling cmd={}".format(command))
         subprocess.call(command)
@@ -0,0 +1,61 @@
+#!/usr/bin/python
+import sys
+import subprocess
+import math
+import glob
+
+import numpy as np
+import json
+
+# Measures the actor initialization time (init_time_seconds) of every class profile with two simc
+# binaries, e.g. before and after a change to the initialization code.
+#
+# Usage: measure_init_time.py <baseline simc binary> <simc binary> [profile.simc ...]
+
+
+def measure(simc_bin, profile, num_repetitions, output_dir):
+    list_init_seconds = []
+
+    for repetition in range(num_repetitions):
+        json_file = output_dir + "/init_time.json"
+        command = "{bin} {profile} iterations=1 threads=1 output={output} json={json}".format(
+            bin=simc_bin, profile=profile, output=output_dir + "/init_time.txt", json=json_file)
+        subprocess.call(command.split(" "), stdout=subprocess.DEVNULL)
+
+        with open(json_file) as f:
+            data = json.load(f)
+            list_init_seconds.append(float(data["sim"]["statistics"]["init_time_seconds"]))
+
+    return np.mean(list_init_seconds), np.std(list_init_seconds) / math.sqrt(num_repetitions)
+
+
+def main():
+    if len(sys.argv) < 3:
+        print("Usage: measure_init_time.py <baseline simc binary> <simc binary> [profile.simc ...]")
+        sys.exit(1)
+
+    baseline_bin = sys.argv[1]
+    simc_bin = sys.argv[2]
+    profiles = sys.argv[3:] if len(sys.argv) > 3 else sorted(glob.glob("../profiles/Tier31/*.simc"))
+    output_dir = "/tmp"
+
+    num_repetitions = 10
+    total_baseline = 0
+    total = 0
+
+    print("{:<44} {:>22} {:>22} {:>9}".format("profile", "baseline init (ms)", "init (ms)", "speedup"))
+    for profile in profiles:
+        base_mean, base_err = measure(baseline_bin, profile, num_repetitions, output_dir)
+        mean, err = measure(simc_bin, profile, num_repetitions, output_dir)
+        total_baseline += base_mean
+        total += mean
+        print("{:<44} {:>13.2f} +/- {:>5.2f} {:>13.2f} +/- {:>5.2f} {:>8.2f}x".format(
+            profile.split("/")[-1], base_mean * 1000, base_err * 1000, mean * 1000, err * 1000,
+            base_mean / mean if mean > 0 else 0))
+
+    print("{:<44} {:>22.2f} {:>22.2f} {:>8.2f}x".format("total", total_baseline * 1000, total * 1000,
+        total_baseline / total if total > 0 else 0))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,69 @@
+#!/usr/bin/python
+import os
+import sys
+import time
+import subprocess
+
+# Measures the peak memory use (maximum resident set size) and the wall clock time of a large
+# profileset sweep with two simc binaries, e.g. before and after a change to the profileset option
+# handling. The sweep appends <count> profilesets, each overriding a single option, to the base
+# profile.
+#
+# Usage: measure_profileset_memory.py <baseline simc binary> <simc binary> <profile.simc> [count]
+
+
+def write_sweep(profile, count, path):
+    with open(profile) as f:
+        base = f.read()
+
+    with open(path, "w") as f:
+        f.write(base)
+        f.write("\n")
+        for i in range(count):
+            f.write("profileset.\"sweep_{i}\"+=gear_crit_rating={rating}\n".format(i=i, rating=100 + i))
+
+
+def measure(simc_bin, sweep_file, output_dir):
+    command = "{bin} {sweep} iterations=10 threads=1 profileset_init_threads=1 output={output}".format(
+        bin=simc_bin, sweep=sweep_file, output=output_dir + "/profileset_memory.txt")
+
+    start = time.time()
+    process = subprocess.Popen(command.split(" "), stdout=subprocess.DEVNULL)
+    _, status, usage = os.wait4(process.pid, 0)
+    elapsed = time.time() - start
+
+    if status != 0:
+        print("{} failed with status {}".format(simc_bin, status))
+        sys.exit(1)
+
+    # ru_maxrss is in kilobytes on Linux
+    return usage.ru_maxrss / 1024.0, elapsed
+
+
+def main():
+    if len(sys.argv) < 4:
+        print("Usage: measure_profileset_memory.py <baseline simc binary> <simc binary> <profile.simc> [count]")
+        sys.exit(1)
+
+    baseline_bin = sys.argv[1]
+    simc_bin = sys.argv[2]
+    profile = sys.argv[3]
+    count = int(sys.argv[4]) if len(sys.argv) > 4 else 10000
+    output_dir = "/tmp"
+
+    sweep_file = output_dir + "/profileset_sweep.simc"
+    write_sweep(profile, count, sweep_file)
+
+    base_rss, base_elapsed = measure(baseline_bin, sweep_file, output_dir)
+    rss, elapsed = measure(simc_bin, sweep_file, output_dir)
+
+    print("{} profilesets of {}".format(count, profile.split("/")[-1]))
+    print("{:<10} {:>16} {:>12}".format("", "peak memory (MB)", "time (s)"))
+    print("{:<10} {:>16.1f} {:>12.2f}".format("baseline", base_rss, base_elapsed))
+    print("{:<10} {:>16.1f} {:>12.2f}".format("new", rss, elapsed))
+    print("{:<10} {:>15.2f}x {:>11.2f}x".format("ratio", base_rss / rss if rss > 0 else 0,
+        base_elapsed / elapsed if elapsed > 0 else 0))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,70 @@
+#!/usr/bin/python
+import sys
+import struct
+import numpy
+
+# Reads the columnar per-iteration results written by results_binary=<file>. The columns are memory
+# mapped numpy arrays, nothing is parsed or copied. The layout must match engine/util/results_binary.hpp.
+#
+# Usage: read_results_binary.py <results file>    prints the columns with their mean and row count
+
+MAGIC = b'SCRESBIN'
+FORMAT_VERSION = 1
+ALIGNMENT = 16
+
+HEADER = struct.Struct('<8sIIQQ')
+COLUMN_ENTRY = struct.Struct('<IIIIQQ')
+
+
+def read_results(path):
+    """Returns the iteration count and a dict of (actor, metric) -> numpy array, the actor of sim-scope
+    columns is empty"""
+    data = numpy.memmap(path, dtype=numpy.uint8, mode='r')
+    size = len(data)
+
+    # Same checks as results_binary::reader_t::validate()
+    if size < HEADER.size:
+        raise ValueError('{} is not a results file'.format(path))
+
+    magic, version, column_count, iterations, string_table_offset = HEADER.unpack_from(data, 0)
+    if magic != MAGIC:
+        raise ValueError('{} is not a results file'.format(path))
+    if version != FORMAT_VERSION:
+        raise ValueError('{} has format version {}, expected {}'.format(path, version, FORMAT_VERSION))
+    if HEADER.size + column_count * COLUMN_ENTRY.size > string_table_offset or string_table_offset > size:
+        raise ValueError('Results file {} is truncated'.format(path))
+
+    columns = {}
+    for i in range(column_count):
+        actor_offset, actor_length, metric_offset, metric_length, row_count, offset = \
+            COLUMN_ENTRY.unpack_from(data, HEADER.size + i * COLUMN_ENTRY.size)
+        if string_table_offset + actor_offset + actor_length > size or \
+           string_table_offset + metric_offset + metric_length > size:
+            raise ValueError('Results file {} has an invalid column name'.format(path))
+
+        actor = bytes(data[string_table_offset + actor_offset:string_table_offset + actor_offset + actor_length])
+        metric = bytes(data[string_table_offset + metric_offset:string_table_offset + metric_offset + metric_length])
+        if offset % ALIGNMENT != 0 or offset > size or row_count > (size - offset) // 8:
+            raise ValueError('Results file {} column {} is out of bounds'.format(path, metric.decode('utf-8')))
+
+        columns[(actor.decode('utf-8'), metric.decode('utf-8'))] = \
+            numpy.frombuffer(data, dtype='<f8', count=row_count, offset=offset)
+
+    return iterations, columns
+
+
+def main():
+    if len(sys.argv) < 2:
+        print("Usage: read_results_binary.py <results file>")
+        sys.exit(1)
+
+    iterations, columns = read_results(sys.argv[1])
+
+    print("{} iterations, {} columns".format(iterations, len(columns)))
+    for (actor, metric), rows in columns.items():
+        print("{:<30} {:<32} {:>10} {:>16.3f}".format(actor or "sim", metric, len(rows),
+            rows.mean() if len(rows) else 0))
+
+
+if __name__ == "__main__":
+    main()
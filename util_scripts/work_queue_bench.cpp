@@ -0,0 +1,117 @@
+// ==========================================================================
+// Dedmonwakeen's Raid DPS/TPS Simulator.
+// Send questions to natehieter@gmail.com
+// ==========================================================================
+
+// Thread scaling benchmark of the shared work queue ( engine/sim/work_queue.hpp ), compared to the
+// mutex protected queue it replaced. Threads claim iterations with the loop of sim_t::iterate(), an
+// iteration is a fixed amount of busy work, so the difference between the queues is the claiming
+// overhead and contention.
+//
+// Build and run from the repository root:
+//   c++ -O2 -std=c++17 -pthread -I engine -I engine/include -I engine/lib \
+//       util_scripts/work_queue_bench.cpp -o work_queue_bench
+//   ./work_queue_bench [iterations] [work per iteration] [max threads]
+//
+// Defaults are 200000 iterations of 2000 units of work, and 1 to 128 threads.
+
+#include "sim/work_queue.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+namespace
+{
+// The work queue before lock-free claiming, every call takes the queue mutex
+struct mutex_work_queue_t
+{
+  std::recursive_mutex m;
+  using G = std::lock_guard<std::recursive_mutex>;
+  int total_work = 0, work = 0;
+
+  struct chunk_t {};
+
+  void init( int w )    { G l( m ); total_work = w; }
+  void consumers( int ) {}
+  bool more_work( const chunk_t& ) { G l( m ); return work < total_work; }
+  size_t pop( chunk_t& )
+  {
+    G l( m );
+    if ( work < total_work )
+      ++work;
+    return 0;
+  }
+};
+
+volatile uint64_t sink;
+
+void iteration( int work )
+{
+  uint64_t x = 0;
+  for ( int i = 0; i < work; ++i )
+    x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+  sink = x;
+}
+
+template <typename Queue>
+double run( int threads, int iterations, int work, int& done )
+{
+  Queue queue;
+  queue.init( iterations );
+  queue.consumers( threads );
+
+  std::vector<int> work_done( threads );
+  auto start = std::chrono::steady_clock::now();
+
+  std::vector<std::thread> workers;
+  for ( int t = 0; t < threads; ++t )
+  {
+    workers.emplace_back( [ &, t ] {
+      typename Queue::chunk_t chunk;
+      bool more_work = true;
+      do
+      {
+        iteration( work );
+        ++work_done[ t ];
+        queue.pop( chunk );
+        more_work = queue.more_work( chunk );
+      } while ( more_work );
+    } );
+  }
+
+  for ( auto& w : workers )
+    w.join();
+
+  done = 0;
+  for ( int n : work_done )
+    done += n;
+
+  return std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+}
+}  // unnamed namespace
+
+int main( int argc, char** argv )
+{
+  int iterations  = argc > 1 ? std::atoi( argv[ 1 ] ) : 200000;
+  int work        = argc > 2 ? std::atoi( argv[ 2 ] ) : 2000;
+  int max_threads = argc > 3 ? std::atoi( argv[ 3 ] ) : 128;
+
+  std::printf( "iterations=%d work=%d hardware_concurrency=%u\n", iterations, work,
+               std::thread::hardware_concurrency() );
+  std::printf( "%8s %12s %12s %14s %14s %8s\n", "threads", "mutex_s", "lockfree_s", "mutex_it/s", "lockfree_it/s",
+               "ratio" );
+
+  for ( int threads = 1; threads <= max_threads; threads *= 2 )
+  {
+    int mutex_done = 0, lockfree_done = 0;
+    double mutex_time    = run<mutex_work_queue_t>( threads, iterations, work, mutex_done );
+    double lockfree_time = run<work_queue_t>( threads, iterations, work, lockfree_done );
+
+    std::printf( "%8d %12.4f %12.4f %14.0f %14.0f %8.2f\n", threads, mutex_time, lockfree_time,
+                 mutex_done / mutex_time, lockfree_done / lockfree_time, mutex_time / lockfree_time );
+  }
+
+  return 0;
+}